@@ -0,0 +1,111 @@
+/**
+ * examples/raster_headless.c — ヘッドレス描画 / ゴールデン比較 / fill rate 計測
+ *
+ * 使い方: ui_raster_headless [出力.ppm|出力.png] [ゴールデン.ppm] [反復回数]
+ *   - 固定入力で 1 フレーム分の UI を更新・描画して書き出す
+ *   - ゴールデンを指定すると比較し、差分があれば終了コード 1
+ *     (ゴールデンが読めない・書き出し失敗などは終了コード 2)
+ *   - 反復回数ぶん同じフレームを描き直して fill rate を表示する
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#include "eng_ui.h"
+#include "ui_raster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W 800
+#define H 600
+
+/* hello_ui.jp と同じ配置のフレームを描く */
+static void draw_frame(UIRaster* r) {
+    ui_raster_clear(r, 30/255.f, 30/255.f, 40/255.f, 1.0f);
+
+    ui_raster_button(r, 50, 50, 200, 50, ui_button(1, 50, 50, 200, 50));
+    ui_raster_slider(r, 50, 180, 300, 24, ui_slider(3, 50, 180, 300, 24, 0.5f));
+    ui_raster_progress(r, 50, 230, 200, 20, ui_progress(4, 50, 230, 200, 20, 0.35f));
+
+    /* スクロール領域: 中身をクリップして描く */
+    float sc = ui_scroll(5, 420, 50, 300, 200, 800, 0.0f);
+    ui_raster_push_clip(r, 420, 50, 300, 200);
+    for (int i = 0; i < 20; ++i) {
+        float iy = 50 + i * 40 - sc;
+        ui_raster_button(r, 430, iy, 270, 36, ui_button(100 + i, 430, iy, 270, 36));
+    }
+    ui_raster_pop_clip(r);
+    ui_raster_scroll(r, 420, 50, 300, 200, 800, sc);
+
+    for (int i = 0; i < 3; ++i) {
+        float tx = 50 + i * 110;
+        ui_raster_tab(r, tx, 280, 100, 30, ui_tab(20 + i, 7, tx, 280, 100, 30, i == 0));
+    }
+
+    int sel = ui_dropdown(6, 50, 330, 200, 30, NULL, 4, 1);
+    ui_raster_dropdown(r, 50, 330, 200, 30, 4, sel, ui_dropdown_open(6));
+
+    /* 半透明オーバーレイ (ブレンド経路) */
+    ui_raster_fill_rect(r, 0, 500, W, 100, 0.0f, 0.0f, 0.0f, 0.5f);
+}
+
+int main(int argc, char** argv) {
+    const char* out    = argc > 1 ? argv[1] : "frame.ppm";
+    const char* golden = argc > 2 && argv[2][0] ? argv[2] : NULL;
+    int         iters  = argc > 3 ? atoi(argv[3]) : 200;
+
+    UIRaster* r = ui_raster_create(W, H);
+    if (!r) { fprintf(stderr, "バッファ確保に失敗\n"); return 2; }
+
+    ui_init();
+    /* ドロップダウンを開いた状態にする (ヘッダーをクリック) */
+    ui_update(60, 340, true, true, false);
+    ui_dropdown(6, 50, 330, 200, 30, NULL, 4, 1);
+    /* マウスは 2 番目のタブ上 */
+    ui_update(180, 290, false, false, false);
+    draw_frame(r);
+
+    size_t n = strlen(out);
+    bool png = n > 4 && strcmp(out + n - 4, ".png") == 0;
+    if (!(png ? ui_raster_write_png(r, out) : ui_raster_write_ppm(r, out))) {
+        fprintf(stderr, "書き出し失敗: %s\n", out);
+        ui_raster_destroy(r);
+        return 2;
+    }
+
+    int rc = 0;
+    if (golden) {
+        UIRaster* gd = ui_raster_read_ppm(golden);
+        if (!gd) {
+            fprintf(stderr, "ゴールデン読み込み失敗: %s\n", golden);
+            ui_raster_destroy(r);
+            return 2;
+        }
+        long diff = ui_raster_compare(r, gd, 0, false);
+        if (diff != 0) {
+            fprintf(stderr, "ゴールデン不一致: %s (%ld px)\n", golden, diff);
+            rc = 1;
+        } else {
+            printf("ゴールデン一致: %s\n", golden);
+        }
+        ui_raster_destroy(gd);
+    }
+
+    ui_raster_reset_stats(r);
+    for (int i = 0; i < iters; ++i) {
+        ui_raster_begin_frame(r);
+        draw_frame(r);
+        ui_raster_end_frame(r);
+    }
+    UIRasterStats st;
+    ui_raster_stats(r, &st);
+    if (st.frames > 0 && st.seconds > 0.0) {
+        double px = (double)(st.pixels_filled + st.pixels_blended);
+        printf("frames=%d rects/frame=%.1f fill=%.1f Mpix/s (blend %.1f%%) "
+               "frame=%.3f ms\n",
+               iters, (double)st.rects / iters, px / st.seconds * 1e-6,
+               px > 0 ? 100.0 * (double)st.pixels_blended / px : 0.0,
+               st.seconds * 1e3 / (double)st.frames);
+    }
+    ui_raster_destroy(r);
+    return rc;
+}
@@ -86,6 +86,286 @@ const char* ui_text_field(int id, const char* append, int backspace_count,
 /** テキストフィールドのバッファをクリア。 */
 void ui_text_field_clear(int id);
 
+/* ── 複数行テキストエリア ───────────────────────────────*/
+/*
+ * 数百 KB の文書を扱える複数行エディタの状態。
+ * 文書は「1 行 = 1 葉」のロープ (平衡木) で保持し、各部分木に
+ * バイト数・論理行数・折り返し後の表示行数を持たせるので、
+ * 行頭オフセット・キャレット移動・クリック位置→キャレット・表示行の特定は
+ * いずれも文書サイズに対して O(log n)。折り返しは等幅 (char_w) 前提で、
+ * 編集した行だけ再計算される (幅が変わったときのみ全行)。
+ * ただし 1 行は分割せず 1 本の文字列で持つため、行内の編集とキャレット計算は
+ * その行の長さに比例する。O(log n) が効くのは短い行が多数ある文書で、
+ * 数百 KB が 1 行に詰まった文書 (圧縮 JSON など) では 1 打鍵ごとに線形になる。
+ * 描画は jp 側が行い、C 側は表示範囲の行だけを返す。
+ */
+
+/** キャレット移動方向 (ui_textarea_move)。上下は折り返し後の表示行単位。 */
+enum {
+    UI_CARET_LEFT, UI_CARET_RIGHT, UI_CARET_UP, UI_CARET_DOWN,
+    UI_CARET_HOME, UI_CARET_END,               /* 表示行の先頭/末尾 */
+    UI_CARET_PAGE_UP, UI_CARET_PAGE_DOWN,
+    UI_CARET_DOC_START, UI_CARET_DOC_END
+};
+
+/**
+ * フレームごとに呼ぶ。ホイールスクロール (wheel_dy 正=下, 3 行単位) と
+ * クリックによるフォーカス・キャレット配置を処理する。
+ * 戻り値: フォーカス中かどうか (キー入力を渡すべきか)。
+ */
+bool ui_textarea(int id, float x, float y, float w, float h, float wheel_dy);
+
+/**
+ * 等幅フォントの 1 文字幅と行の高さ、折り返し有無を設定する
+ * (既定: 8, 16, 折り返しあり)。
+ */
+void ui_textarea_config(int id, float char_w, float line_h, bool wrap);
+
+/** 文書全体を text で置き換え、キャレットを先頭に置く。 */
+void ui_textarea_set_text(int id, const char* text);
+
+/** キャレット位置に text を挿入する ('\n' で改行、'\r' は無視)。 */
+void ui_textarea_insert(int id, const char* text);
+
+/** キャレット前の count 文字 (コードポイント) を削除。行頭では前の行と結合。 */
+void ui_textarea_backspace(int id, int count);
+
+/** キャレット後の count 文字を削除。行末では次の行と結合。 */
+void ui_textarea_delete(int id, int count);
+
+/** キャレットを移動する。dir = UI_CARET_*。 */
+void ui_textarea_move(int id, int dir, int count);
+
+/**
+ * 文書全体を buf にコピーする (NUL 終端, 入り切らない分は切り捨て)。
+ * 戻り値: 文書全体のバイト数。
+ */
+long ui_textarea_get_text(int id, char* buf, long size);
+
+/** 論理行数 (改行数 + 1)。 */
+int  ui_textarea_line_count(int id);
+
+/**
+ * キャレット位置。line/col は 0 始まり (col はコードポイント単位)、
+ * px/py は最後の ui_textarea 呼び出しの矩形を基準にした画面座標。NULL 可。
+ */
+void ui_textarea_caret(int id, int* line, int* col, float* px, float* py);
+
+/**
+ * 表示範囲 (矩形に収まる表示行) の文字列を '\n' 区切りで返す。
+ * 戻り値は次に同じ id で呼ぶまで有効。first_line には先頭表示行が属する
+ * 論理行番号を書く (NULL 可)。
+ */
+const char* ui_textarea_visible_text(int id, int* first_line);
+
+/* ── テーブル ───────────────────────────────────────────*/
+/*
+ * 列データを一度だけ型付き配列で受け取り、ヘッダークリックでソートする表。
+ * ソート結果は並べ替え順 (permutation) としてキャッシュし、データ自体は動かさない。
+ * - 数値列は基数ソート (安定, O(n))。大きな表はスレッドで分割ソートしてマージ
+ * - 少数のセル更新は変更行だけを抜き出してソートし直し、既存順にマージする
+ * - 描画は jp 側。C 側は表示範囲の行 (ソート後の順) だけを返す
+ * 同値の行は元の行番号順に並ぶ (昇順・降順とも)。
+ */
+
+/** 列の型。 */
+enum { UI_TABLE_F64, UI_TABLE_I64, UI_TABLE_STR };
+
+/** 列数・行数を設定し、既存データとソート状態を破棄する。失敗時 false。 */
+bool ui_table_setup(int id, int columns, int rows);
+
+/** 列データを設定 (内部にコピー)。rows が表の行数より少なければ残りは 0 / 空。 */
+void ui_table_set_column_f64(int id, int col, const double* data, int rows);
+void ui_table_set_column_i64(int id, int col, const int64_t* data, int rows);
+void ui_table_set_column_str(int id, int col, const char* const* data, int rows);
+
+/**
+ * 1 セル更新。ソート列なら次回参照時に差分だけ並べ替える。
+ * 値は列の現在の型に変換して書く (列の型を変えるのは set_column_* だけ)。
+ *   実数→整数列: 小数部を切り捨て、範囲外は飽和。NaN は無視
+ *   整数→実数列: double へ変換
+ *   数値→文字列列: ui_table_get_str と同じ書式 (%lld / %g)
+ *   文字列→数値列: 全体が数値として読めるときだけ書き、それ以外は無視
+ * まだデータの無い列は、最初に書いた値の型になる。
+ */
+void ui_table_set_cell_f64(int id, int col, int row, double v);
+void ui_table_set_cell_i64(int id, int col, int row, int64_t v);
+void ui_table_set_cell_str(int id, int col, int row, const char* v);
+
+/** 列幅 (既定は表の幅を等分)。ヘッダークリックの判定に使う。 */
+void ui_table_set_column_width(int id, int col, float w);
+
+/**
+ * フレームごとに呼ぶ。ヘッダークリックでソート列/方向を切り替え
+ * (同じ列なら昇順⇔降順)、ホイール (3 行単位) でスクロール、行クリックで選択。
+ * 戻り値: このフレームでクリックされたデータ行番号 (無ければ -1)。
+ */
+int  ui_table(int id, float x, float y, float w, float h,
+              float header_h, float row_h, float wheel_dy);
+
+/** ソート列と方向を直接指定する。col = -1 で元の順。 */
+void ui_table_sort(int id, int col, bool descending);
+
+/** 現在のソート列 (-1 = 無し)。descending は NULL 可。 */
+int  ui_table_sort_column(int id, bool* descending);
+
+/** 表示範囲の行数を返し、*first に先頭の表示位置 (ソート後の順位) を書く。 */
+int  ui_table_visible(int id, int* first);
+
+/** ソート後の順位 pos にあるデータ行番号 (範囲外は -1)。 */
+int  ui_table_row_at(int id, int pos);
+
+/** 選択中のデータ行番号 (-1 = 無し)。 */
+int  ui_table_selected(int id);
+
+/** セル値。数値取得では文字列列は 0、文字列取得では数値を書式化して返す。 */
+double      ui_table_get_f64(int id, int col, int row);
+const char* ui_table_get_str(int id, int col, int row);
+
+/* ── ツリービュー ───────────────────────────────────────*/
+/*
+ * 10 万ノード級の階層表示。ノードは parent / first_child / next_sibling 配列と
+ * 展開フラグで保持し、表示中のノードを深さ優先順に並べた平坦配列を持つ。
+ * - 展開/折り畳みは該当部分木の分だけ平坦配列を挿入/削除する (全体を走査しない)
+ * - スクロールとクリック判定は平坦配列の添字 1 回 (O(1))
+ * - 子は展開時に遅延読み込みできる (C はコールバック、jp は読込要求を取得)
+ * ノード番号は 1 から。親に -1 (または 0) を渡すと最上位に追加する。
+ */
+
+/** 子の読み込み要求。node の子を ui_tree_add で追加する。 */
+typedef void (*UITreeLoadFn)(int tree_id, int node, void* user);
+
+/** ツリーを空にする (ノード・展開状態・選択を破棄)。 */
+void ui_tree_clear(int id);
+
+/**
+ * parent の最後の子としてノードを追加し、ノード番号を返す (失敗時 -1)。
+ * has_children = true なら子が未読み込みでも展開可能として扱う。
+ * parent が展開・表示中なら平坦配列にも即座に挿入される。
+ */
+int  ui_tree_add(int id, int parent, const char* label, bool has_children);
+
+/**
+ * node の子孫をすべて取り除き、未読み込みに戻す (再読み込み用)。
+ * 取り除いたノード番号は以後の ui_tree_add で再利用される。
+ */
+void ui_tree_remove_children(int id, int node);
+
+/**
+ * 子の遅延読み込みコールバックを設定する。未設定の場合、未読み込みノードの
+ * 展開は読込要求キューに積まれ (ui_tree_pending_load)、展開は保留される。
+ */
+void ui_tree_set_loader(int id, UITreeLoadFn fn, void* user);
+
+/** 展開/折り畳み。未読み込みの子があれば読み込み (または要求) する。 */
+void ui_tree_expand(int id, int node, bool expanded);
+
+bool ui_tree_is_expanded(int id, int node);
+
+/**
+ * 読込要求キューから 1 件取り出す (無ければ -1)。取り出したノードは読み込み済み
+ * 扱いになるので、子を ui_tree_add してから ui_tree_expand(node, true) を呼ぶ。
+ */
+int  ui_tree_pending_load(int id);
+
+/**
+ * フレームごとに呼ぶ。ホイール (3 行単位) でスクロール、行クリックで選択。
+ * 行の左端 (深さ+1)*indent 以内のクリックは展開/折り畳み。
+ * 戻り値: このフレームでクリック (選択) されたノード (無ければ -1)。
+ */
+int  ui_tree(int id, float x, float y, float w, float h,
+             float row_h, float indent, float wheel_dy);
+
+/** 表示範囲の行数を返し、*first に先頭の平坦配列添字を書く。 */
+int  ui_tree_visible(int id, int* first);
+
+/** 平坦配列 (表示順) の row 番目のノード (範囲外は -1)。 */
+int  ui_tree_row_node(int id, int row);
+
+/** 表示中のノード総数 (平坦配列の長さ)。 */
+int  ui_tree_visible_count(int id);
+
+/** ノード情報。範囲外なら -1 / "" / false。 */
+int         ui_tree_node_depth(int id, int node);
+int         ui_tree_node_parent(int id, int node);
+const char* ui_tree_node_label(int id, int node);
+bool        ui_tree_node_has_children(int id, int node);
+
+/** 選択中のノード (-1 = 無し)。 */
+int  ui_tree_selected(int id);
+
+/* ── プロット ───────────────────────────────────────────*/
+/*
+ * 数百万サンプルの時系列を描画幅まで間引いて折れ線にする。
+ * - サンプルはリングバッファに保持 (満杯なら古いものから上書き)。
+ *   サンプル番号は clear からの通し番号で、上書きされても番号は変わらない
+ * - 間引きは 1 ピクセル列ごとの最小/最大 (MINMAX) か、その候補から
+ *   LTTB (Largest-Triangle-Three-Buckets) で 1 点を選ぶ (LTTB)
+ * - 64 / 512 / 4096 ... サンプル単位の最小/最大を階層キャッシュし、
+ *   列の集計は端数だけ生データを SIMD で走査する
+ * - 列はサンプル番号の固定グリッドに揃えてキャッシュするので、
+ *   パンやストリーミングでは新しく現れた列だけを計算する
+ * 描画は jp 側。C 側は画面座標の点列を返す。
+ */
+
+/** 間引き方式。 */
+enum { UI_PLOT_MINMAX, UI_PLOT_LTTB };
+
+/** 画面座標の点。 */
+typedef struct { float x, y; } UIPlotPoint;
+
+/** リング容量 (2 の冪に切り上げ, 最小 64) を確保し、データを破棄する。失敗時 false。 */
+bool ui_plot_setup(int id, int capacity);
+
+/** サンプルを破棄して番号を 0 に戻す (容量・表示設定は維持)。 */
+void ui_plot_clear(int id);
+
+/** サンプルを末尾に追加する。ui_plot_setup 前は無視。 */
+void ui_plot_push(int id, const float* values, int n);
+
+/** 次に追加されるサンプル番号 (= 追加総数) と、保持している最古の番号。 */
+int64_t ui_plot_total(int id);
+int64_t ui_plot_oldest(int id);
+
+/** 番号 index のサンプル値 (保持範囲外は 0)。 */
+float ui_plot_sample(int id, int64_t index);
+
+/** 表示範囲を番号 [first, first+count) に固定する。count <= 0 で保持範囲全体。 */
+void ui_plot_set_view(int id, int64_t first, int64_t count);
+
+/** 最新 count サンプルを追従表示する (既定, count <= 0 で保持範囲全体)。 */
+void ui_plot_follow(int id, int64_t count);
+
+/** 現在の (保持範囲にクランプ済みの) 表示範囲。引数は NULL 可。 */
+void ui_plot_get_view(int id, int64_t* first, int64_t* count);
+
+/** 間引き方式 (UI_PLOT_MINMAX / UI_PLOT_LTTB)。 */
+void ui_plot_set_mode(int id, int mode);
+
+/**
+ * Y 軸の範囲。lo >= hi で自動 (表示範囲の最小/最大)。
+ * 範囲外の点の画面 Y は [y - h, y + 2h] に抑えられる。
+ */
+void ui_plot_set_y_range(int id, float lo, float hi);
+
+/** 直近の点列計算で使った Y 軸の範囲。引数は NULL 可。 */
+void ui_plot_get_y_range(int id, float* lo, float* hi);
+
+/**
+ * フレームごとに呼ぶ。ホイールでカーソル位置を中心にズーム、ドラッグでパン
+ * (パンすると追従は解除)。点列を必要なら再計算する。
+ * 戻り値: カーソル下のサンプル番号 (カーソル列のうち値がカーソルに最も近いもの,
+ *         ホバーしていなければ -1)。
+ */
+int64_t ui_plot(int id, float x, float y, float w, float h, float wheel_dy);
+
+/**
+ * 直近の ui_plot の矩形に合わせた点列を返す。MINMAX は列ごとに 2 点
+ * (最小・最大を前の点に近い順)、LTTB は列ごとに 1 点。表示範囲が幅以下なら
+ * 生サンプルをそのまま返す。ポインタは次に同じ id を操作するまで有効。
+ */
+int  ui_plot_points(int id, const UIPlotPoint** pts);
+
 /* ── レイアウトヘルパー ─────────────────────────────────*/
 
 /** レイアウトカーソル初期化。(origin_x, origin_y) からスタート。 */
@@ -166,6 +446,53 @@ bool ui_tab(int id, int group_id, float x, float y, float w, float h,
 /** group_id で現在選択されているタブIDを返す (0=未選択)。 */
 int  ui_tab_selected(int group_id);
 
+/* ── プロファイル ───────────────────────────────────────*/
+/*
+ * ui_profile_begin/end で囲んだ区間 (ゾーン) を単調増加クロックで計測する。
+ * 入れ子可 (最大 32 段)。記録は固定長リングバッファで、古いものから上書き。
+ * 有効化するまで begin/end は何もしない。ライブラリ内部の処理
+ * (ウィジェット検索・グループ走査など) は "ui." で始まる名前で自動記録される。
+ */
+
+/** 1 ゾーン名あたりの集計 (時間は マイクロ秒)。 */
+typedef struct {
+    const char* name;
+    uint64_t    count;
+    double      min_us, avg_us, max_us, total_us;
+} UIProfileZoneStats;
+
+/**
+ * 計測の有効/無効を切り替える (既定は無効)。切り替え時に開いているゾーンは
+ * 破棄され、対応する ui_profile_end は無視される。
+ */
+void ui_profile_enable(bool enabled);
+bool ui_profile_enabled(void);
+
+/** 記録と集計を全て破棄し、時刻の基準を現在にする。 */
+void ui_profile_reset(void);
+
+/** ゾーン開始。name は 31 バイトまで (内部に複製されるので一時文字列で可)。 */
+void ui_profile_begin(const char* name);
+
+/** 直近の ui_profile_begin に対応するゾーンを閉じる。 */
+void ui_profile_end(void);
+
+/** 記録されたゾーン名の数。 */
+int  ui_profile_zone_count(void);
+
+/** index 番目のゾーン名の min/avg/max 集計。範囲外なら false。 */
+bool ui_profile_zone_stats(int index, UIProfileZoneStats* out);
+
+/**
+ * 集計を CSV (zone,count,min_us,avg_us,max_us,total_us) で buf に書く。
+ * zone 列は常に引用符で囲み、名前中の '"' は "" にする (RFC 4180)。
+ * 戻り値: 書き込んだバイト数 (NUL 除く)。
+ */
+int  ui_profile_summary(char* buf, int size);
+
+/** リング内のゾーンを Chrome trace-event JSON (chrome://tracing 等) で書き出す。 */
+bool ui_profile_export_chrome(const char* path);
+
 #ifdef __cplusplus
 }
 #endif
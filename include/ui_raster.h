@@ -0,0 +1,143 @@
+/**
+ * include/ui_raster.h — engine_ui ヘッドレス CPU ラスタライザ
+ *
+ * GPU もウィンドウも無い環境 (CI 等) で UI フレームを RGBA メモリバッファに
+ * 描画し、ゴールデンイメージ比較と描画コスト計測を行うための参照実装。
+ * - 塗り潰し/アルファブレンドは SIMD (SSE2 / NEON) のスパン単位で処理
+ * - クリップ矩形はスタックで入れ子にできる
+ * - ウィジェットはデフォルトテーマ (ui_button_color 等) で描画する
+ * - 出力は PPM (P6) / PNG (非圧縮 deflate)
+ *
+ * プラグイン本体 (engine_ui.hjp) には含まれない。CMake オプション
+ * ENGINE_UI_BUILD_RASTER=ON で静的ライブラリ engine_ui_raster をビルドする。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 描画先バッファ (RGBA8, 行間隔 = width * 4 バイト)。 */
+typedef struct UIRaster UIRaster;
+
+/** 描画コスト統計。fill rate = (pixels_filled + pixels_blended) / seconds。 */
+typedef struct {
+    uint64_t pixels_filled;   /* 不透明スパン塗り潰しピクセル数 */
+    uint64_t pixels_blended;  /* アルファブレンドしたピクセル数 */
+    uint64_t spans;           /* 処理したスパン (行) 数 */
+    uint64_t rects;           /* 描画した矩形数 (クリップで消えたものを除く) */
+    uint64_t frames;          /* begin_frame〜end_frame で計測したフレーム数 */
+    double   seconds;         /* 計測したフレームの合計時間 (単調増加クロック) */
+} UIRasterStats;
+
+/* ── バッファ管理 ───────────────────────────────────────*/
+
+/** w×h の描画先を確保する (透明黒で初期化)。失敗時 NULL。 */
+UIRaster* ui_raster_create(int width, int height);
+
+/** 描画先を解放する。NULL 可。 */
+void ui_raster_destroy(UIRaster* r);
+
+int            ui_raster_width(const UIRaster* r);
+int            ui_raster_height(const UIRaster* r);
+
+/** 先頭ピクセルへのポインタ (R,G,B,A の順に 1 バイトずつ)。 */
+const uint8_t* ui_raster_pixels(const UIRaster* r);
+
+/* ── 基本描画 ───────────────────────────────────────────*/
+
+/** 全面を指定色で塗る (クリップ・ブレンド無視)。色は 0.0〜1.0。 */
+void ui_raster_clear(UIRaster* r, float cr, float cg, float cb, float ca);
+
+/**
+ * 矩形塗り潰し。ca >= 1 ならスパン塗り潰し、0 < ca < 1 ならアルファブレンド。
+ * 座標は四捨五入してピクセル境界に合わせ、現在のクリップ矩形で切り取る。
+ */
+void ui_raster_fill_rect(UIRaster* r, float x, float y, float w, float h,
+                         float cr, float cg, float cb, float ca);
+
+/** 矩形枠 (内側に thickness ピクセル)。 */
+void ui_raster_rect_outline(UIRaster* r, float x, float y, float w, float h,
+                            float thickness,
+                            float cr, float cg, float cb, float ca);
+
+/**
+ * クリップ矩形を積む (現在のクリップとの交差になる)。最大 16 段。
+ * 超えた push は無視され (外側のクリップのまま)、同じ数の pop も無視される。
+ */
+void ui_raster_push_clip(UIRaster* r, float x, float y, float w, float h);
+
+/** クリップ矩形を 1 段戻す。 */
+void ui_raster_pop_clip(UIRaster* r);
+
+/* ── ウィジェット (デフォルトテーマ) ───────────────────*/
+/* 引数は対応する ui_* 関数の引数・戻り値をそのまま渡す。 */
+
+/** ボタン。state = ui_button の戻り値。 */
+void ui_raster_button(UIRaster* r, float x, float y, float w, float h,
+                      int state);
+
+/** 水平スライダー。norm_val = ui_slider の戻り値。 */
+void ui_raster_slider(UIRaster* r, float x, float y, float w, float h,
+                      float norm_val);
+
+/** スクロールバー。scroll = ui_scroll の戻り値 (ui_scroll と同じ幾何)。 */
+void ui_raster_scroll(UIRaster* r, float x, float y, float w, float view_h,
+                      float content_h, float scroll);
+
+/** プログレスバー。value = ui_progress の戻り値。 */
+void ui_raster_progress(UIRaster* r, float x, float y, float w, float h,
+                        float value);
+
+/**
+ * ドロップダウン。selected = ui_dropdown の戻り値, open = ui_dropdown_open。
+ * 開いている間はヘッダー直下に count 行の選択肢を描く (ui_dropdown と同じ幾何)。
+ */
+void ui_raster_dropdown(UIRaster* r, float x, float y, float w, float h,
+                        int count, int selected, bool open);
+
+/** タブ。selected = ui_tab の戻り値。 */
+void ui_raster_tab(UIRaster* r, float x, float y, float w, float h,
+                   bool selected);
+
+/* ── 出力・比較 ─────────────────────────────────────────*/
+
+/** PPM (P6, アルファ破棄) で書き出す。成功で true。 */
+bool ui_raster_write_ppm(const UIRaster* r, const char* path);
+
+/** PNG (RGBA8, 非圧縮) で書き出す。成功で true。 */
+bool ui_raster_write_png(const UIRaster* r, const char* path);
+
+/** PPM (P6, maxval 255) を読み込む。アルファは 255。失敗時 NULL。 */
+UIRaster* ui_raster_read_ppm(const char* path);
+
+/**
+ * 2 枚を比較し、いずれかのチャンネル差が tolerance を超えたピクセル数を返す。
+ * compare_alpha = false なら RGB のみ比較 (PPM ゴールデン向け)。
+ * サイズ不一致は -1。
+ */
+long ui_raster_compare(const UIRaster* a, const UIRaster* b,
+                       int tolerance, bool compare_alpha);
+
+/* ── 統計 ───────────────────────────────────────────────*/
+
+/** 累積統計を取得する。 */
+void ui_raster_stats(const UIRaster* r, UIRasterStats* out);
+
+/** 累積統計をリセットする。 */
+void ui_raster_reset_stats(UIRaster* r);
+
+/**
+ * 1 フレーム分の描画を囲んで時間を計る。seconds はこの区間の合計で、
+ * 個々の描画呼び出しでは時刻を取らない。
+ */
+void ui_raster_begin_frame(UIRaster* r);
+void ui_raster_end_frame(UIRaster* r);
+
+#ifdef __cplusplus
+}
+#endif
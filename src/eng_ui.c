@@ -4,6 +4,7 @@
  * Copyright (c) 2026 Reo Shiozawa — MIT License
  */
 #include "eng_ui.h"
+#include "eng_ui_internal.h"
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -58,38 +59,50 @@ static bool rect_contains(float x, float y, float w, float h,
 }
 
 static UIWidget* widget_get(int id) {
-    for (int i = 0; i < UI_MAX_WIDGETS; ++i) {
+    UIWidget* found = NULL;
+    ui_profile_begin("ui.widget_get");
+    for (int i = 0; i < UI_MAX_WIDGETS && !found; ++i) {
         if (g.widgets[i].used && g.widgets[i].id == id)
-            return &g.widgets[i];
+            found = &g.widgets[i];
     }
     /* 新規作成 */
-    for (int i = 0; i < UI_MAX_WIDGETS; ++i) {
+    for (int i = 0; i < UI_MAX_WIDGETS && !found; ++i) {
         if (!g.widgets[i].used) {
             g.widgets[i].id      = id;
             g.widgets[i].used    = true;
             g.widgets[i].norm_val = 0.5f;
-            return &g.widgets[i];
+            found = &g.widgets[i];
         }
     }
-    return NULL;
+    ui_profile_end();
+    return found;
 }
 
 static UITextField* field_get(int id) {
-    for (int i = 0; i < UI_MAX_TEXTFIELDS; ++i)
-        if (g.fields[i].used && g.fields[i].id == id) return &g.fields[i];
-    for (int i = 0; i < UI_MAX_TEXTFIELDS; ++i) {
+    UITextField* found = NULL;
+    ui_profile_begin("ui.field_get");
+    for (int i = 0; i < UI_MAX_TEXTFIELDS && !found; ++i)
+        if (g.fields[i].used && g.fields[i].id == id) found = &g.fields[i];
+    for (int i = 0; i < UI_MAX_TEXTFIELDS && !found; ++i) {
         if (!g.fields[i].used) {
             g.fields[i].id   = id;
             g.fields[i].used = true;
             g.fields[i].buf[0] = '\0';
-            return &g.fields[i];
+            found = &g.fields[i];
         }
     }
-    return NULL;
+    ui_profile_end();
+    return found;
 }
 
 /* ── 初期化・更新 ────────────────────────────────────────*/
-void ui_init(void) { memset(&g, 0, sizeof(g)); }
+void ui_init(void) {
+    memset(&g, 0, sizeof(g));
+    ui_textarea_reset_all();
+    ui_table_reset_all();
+    ui_tree_reset_all();
+    ui_plot_reset_all();
+}
 
 void ui_update(float mx, float my, bool is_down,
                bool just_clicked, bool just_released) {
@@ -99,6 +112,13 @@ void ui_update(float mx, float my, bool is_down,
     g.just_released = just_released;
 }
 
+void ui_mouse_state(float* mx, float* my, bool* is_down, bool* just_clicked) {
+    if (mx) *mx = g.mx;
+    if (my) *my = g.my;
+    if (is_down)      *is_down      = g.is_down;
+    if (just_clicked) *just_clicked = g.just_clicked;
+}
+
 /* ── ヒットテスト ────────────────────────────────────────*/
 bool ui_hover(float x, float y, float w, float h) {
     return rect_contains(x, y, w, h, g.mx, g.my);
@@ -260,10 +280,12 @@ bool ui_radio(int id, int group_id, float x, float y, float w, float h,
     if (!wid->checked && initial_selected) wid->checked = true;
     if (rect_contains(x, y, w, h, g.mx, g.my) && g.just_clicked) {
         /* 同グループの他ウィジェットを全て OFF にしてから自分を ON */
+        ui_profile_begin("ui.group_scan");
         for (int i = 0; i < UI_MAX_WIDGETS; ++i) {
             if (g.widgets[i].used && g.widgets[i].group_id == group_id)
                 g.widgets[i].checked = false;
         }
+        ui_profile_end();
         wid->checked = true;
     }
     return wid->checked;
@@ -354,6 +376,7 @@ bool ui_tab(int id, int group_id, float x, float y, float w, float h,
     wid->group_id = group_id;
 
     /* グループ内の selected_id を探す (まずグループのデフォルト初期化) */
+    ui_profile_begin("ui.group_scan");
     bool any_selected = false;
     for (int i = 0; i < UI_MAX_WIDGETS; i++) {
         if (g.widgets[i].used && g.widgets[i].group_id == group_id
@@ -379,14 +402,20 @@ bool ui_tab(int id, int group_id, float x, float y, float w, float h,
         }
         wid->tab_selected = id;
     }
+    ui_profile_end();
     return wid->tab_selected == id;
 }
 
 /* グループで現在選択されているタブIDを返す (0=未選択) */
 int ui_tab_selected(int group_id) {
+    int sel = 0;
+    ui_profile_begin("ui.group_scan");
     for (int i = 0; i < UI_MAX_WIDGETS; i++) {
-        if (g.widgets[i].used && g.widgets[i].group_id == group_id)
-            return g.widgets[i].tab_selected;
+        if (g.widgets[i].used && g.widgets[i].group_id == group_id) {
+            sel = g.widgets[i].tab_selected;
+            break;
+        }
     }
-    return 0;
+    ui_profile_end();
+    return sel;
 }
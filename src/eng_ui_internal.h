@@ -0,0 +1,16 @@
+/**
+ * src/eng_ui_internal.h — engine_ui ライブラリ内部の共有宣言 (非公開)
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#pragma once
+#include "eng_ui.h"
+
+/** ui_update で渡された現在のマウス状態。不要な引数は NULL 可。 */
+void ui_mouse_state(float* mx, float* my, bool* is_down, bool* just_clicked);
+
+/* ── ui_init から呼ばれる各ウィジェットの後始末 ─────────*/
+void ui_textarea_reset_all(void);
+void ui_table_reset_all(void);
+void ui_tree_reset_all(void);
+void ui_plot_reset_all(void);
@@ -6,6 +6,7 @@
 #include "eng_ui.h"
 #include <hajimu_plugin.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* ── マクロ ──────────────────────────────────────────────*/
@@ -183,6 +184,419 @@ static Value fn_ui_tab_selected(int argc, Value* args) {
     return hajimu_number(ui_tab_selected((int)args[0].number));
 }
 
+/* ── v1.3.0 プロファイル ─────────────────────────────────*/
+static Value fn_ui_profile_enable(int argc, Value* args) {
+    NEED(1);
+    ui_profile_enable(BOOL_(0));
+    return hajimu_null();
+}
+static Value fn_ui_profile_reset(int argc, Value* args) {
+    (void)argc; (void)args;
+    ui_profile_reset();
+    return hajimu_null();
+}
+static Value fn_ui_profile_begin(int argc, Value* args) {
+    NEED(1);
+    ui_profile_begin(STR(0));
+    return hajimu_null();
+}
+static Value fn_ui_profile_end(int argc, Value* args) {
+    (void)argc; (void)args;
+    ui_profile_end();
+    return hajimu_null();
+}
+/* 返値: "zone,count,min_us,avg_us,max_us,total_us" ヘッダ付き CSV 文字列 */
+static Value fn_ui_profile_summary(int argc, Value* args) {
+    (void)argc; (void)args;
+    static char buf[8192];
+    ui_profile_summary(buf, sizeof(buf));
+    return hajimu_string(buf);
+}
+static Value fn_ui_profile_export(int argc, Value* args) {
+    NEED(1);
+    return hajimu_bool(ui_profile_export_chrome(STR(0)));
+}
+
+/* ── v1.3.0 複数行テキストエリア ─────────────────────────*/
+static Value fn_ui_textarea(int argc, Value* args) {
+    /* id, x, y, w, h, wheel → フォーカス中か */
+    NEED(6);
+    return hajimu_bool(ui_textarea((int)args[0].number,
+                                   NUM(1), NUM(2), NUM(3), NUM(4), NUM(5)));
+}
+static Value fn_ui_textarea_config(int argc, Value* args) {
+    /* id, 文字幅, 行高, 折り返し */
+    NEED(4);
+    ui_textarea_config((int)args[0].number, NUM(1), NUM(2), BOOL_(3));
+    return hajimu_null();
+}
+static Value fn_ui_textarea_set_text(int argc, Value* args) {
+    NEED(2);
+    ui_textarea_set_text((int)args[0].number, STR(1));
+    return hajimu_null();
+}
+static Value fn_ui_textarea_insert(int argc, Value* args) {
+    NEED(2);
+    ui_textarea_insert((int)args[0].number, STR(1));
+    return hajimu_null();
+}
+static Value fn_ui_textarea_backspace(int argc, Value* args) {
+    NEED(2);
+    ui_textarea_backspace((int)args[0].number, (int)args[1].number);
+    return hajimu_null();
+}
+static Value fn_ui_textarea_delete(int argc, Value* args) {
+    NEED(2);
+    ui_textarea_delete((int)args[0].number, (int)args[1].number);
+    return hajimu_null();
+}
+static Value fn_ui_textarea_move(int argc, Value* args) {
+    /* id, 方向 (0=左 1=右 2=上 3=下 4=行頭 5=行末 6=PgUp 7=PgDn 8=文書頭 9=文書末), 回数 */
+    NEED(3);
+    ui_textarea_move((int)args[0].number, (int)args[1].number, (int)args[2].number);
+    return hajimu_null();
+}
+/* 文書全体 (保存用)。毎フレームの描画には UIテキストエリア表示 を使う */
+static Value fn_ui_textarea_get_text(int argc, Value* args) {
+    NEED(1);
+    int  id  = (int)args[0].number;
+    long len = ui_textarea_get_text(id, NULL, 0);
+    char* buf = (char*)malloc((size_t)len + 1);
+    if (!buf) return hajimu_string("");
+    ui_textarea_get_text(id, buf, len + 1);
+    Value v = hajimu_string(buf);
+    free(buf);
+    return v;
+}
+static Value fn_ui_textarea_visible(int argc, Value* args) {
+    NEED(1);
+    return hajimu_string(ui_textarea_visible_text((int)args[0].number, NULL));
+}
+static Value fn_ui_textarea_first_line(int argc, Value* args) {
+    NEED(1);
+    int line = 0;
+    ui_textarea_visible_text((int)args[0].number, &line);
+    return hajimu_number(line);
+}
+static Value fn_ui_textarea_line_count(int argc, Value* args) {
+    NEED(1);
+    return hajimu_number(ui_textarea_line_count((int)args[0].number));
+}
+/* 返値: "行,桁,x,y" の CSV 文字列 */
+static Value fn_ui_textarea_caret(int argc, Value* args) {
+    NEED(1);
+    int line = 0, col = 0;
+    float x = 0.0f, y = 0.0f;
+    ui_textarea_caret((int)args[0].number, &line, &col, &x, &y);
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%d,%d,%.1f,%.1f", line, col, x, y);
+    return hajimu_string(buf);
+}
+
+/* ── v1.3.0 テーブル ─────────────────────────────────────*/
+static Value fn_ui_table_setup(int argc, Value* args) {
+    /* id, 列数, 行数 */
+    NEED(3);
+    return hajimu_bool(ui_table_setup((int)args[0].number,
+                                      (int)args[1].number, (int)args[2].number));
+}
+/* 数値列を "1,2.5,3" 形式の CSV で一括設定 */
+static Value fn_ui_table_column_num(int argc, Value* args) {
+    NEED(3);
+    const char* p = STR(2);
+    if (!p) return hajimu_null();
+    size_t n = 1;
+    for (const char* q = p; *q; ++q) if (*q == ',') n++;
+    double* data = (double*)malloc(sizeof(double) * n);
+    if (!data) return hajimu_null();
+    for (size_t i = 0; i < n; ++i) {
+        char* end;
+        data[i] = strtod(p, &end);
+        p = strchr(end, ',');
+        if (!p) { n = i + 1; break; }
+        p++;
+    }
+    ui_table_set_column_f64((int)args[0].number, (int)args[1].number, data, (int)n);
+    free(data);
+    return hajimu_null();
+}
+/* 文字列列を改行区切りで一括設定 */
+static Value fn_ui_table_column_str(int argc, Value* args) {
+    NEED(3);
+    const char* src = STR(2);
+    if (!src) return hajimu_null();
+    size_t len = strlen(src), n = 1;
+    for (const char* q = src; *q; ++q) if (*q == '\n') n++;
+    char*  buf  = (char*)malloc(len + 1);
+    const char** rows = (const char**)malloc(sizeof(char*) * n);
+    if (buf && rows) {
+        memcpy(buf, src, len + 1);
+        size_t i = 0;
+        rows[i++] = buf;
+        for (char* q = buf; *q; ++q)
+            if (*q == '\n') { *q = '\0'; rows[i++] = q + 1; }
+        ui_table_set_column_str((int)args[0].number, (int)args[1].number,
+                                rows, (int)n);
+    }
+    free(buf);
+    free(rows);
+    return hajimu_null();
+}
+static Value fn_ui_table_cell_num(int argc, Value* args) {
+    /* id, 列, 行, 値 */
+    NEED(4);
+    ui_table_set_cell_f64((int)args[0].number, (int)args[1].number,
+                          (int)args[2].number, args[3].number);
+    return hajimu_null();
+}
+static Value fn_ui_table_cell_str(int argc, Value* args) {
+    NEED(4);
+    ui_table_set_cell_str((int)args[0].number, (int)args[1].number,
+                          (int)args[2].number, STR(3));
+    return hajimu_null();
+}
+static Value fn_ui_table_column_width(int argc, Value* args) {
+    NEED(3);
+    ui_table_set_column_width((int)args[0].number, (int)args[1].number, NUM(2));
+    return hajimu_null();
+}
+static Value fn_ui_table(int argc, Value* args) {
+    /* id, x, y, w, h, ヘッダー高, 行高, ホイール → クリックされた行 (-1) */
+    NEED(8);
+    return hajimu_number(ui_table((int)args[0].number, NUM(1), NUM(2), NUM(3),
+                                  NUM(4), NUM(5), NUM(6), NUM(7)));
+}
+static Value fn_ui_table_sort(int argc, Value* args) {
+    /* id, 列 (-1 = 解除), 降順 */
+    NEED(3);
+    ui_table_sort((int)args[0].number, (int)args[1].number, BOOL_(2));
+    return hajimu_null();
+}
+/* 返値: "列,降順(0/1)" の CSV 文字列 */
+static Value fn_ui_table_sort_state(int argc, Value* args) {
+    NEED(1);
+    bool desc = false;
+    int  col  = ui_table_sort_column((int)args[0].number, &desc);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%d,%d", col, desc ? 1 : 0);
+    return hajimu_string(buf);
+}
+/* 返値: 表示範囲のデータ行番号 (ソート後の順) の CSV 文字列 */
+static Value fn_ui_table_visible(int argc, Value* args) {
+    NEED(1);
+    int id = (int)args[0].number, first = 0;
+    int n  = ui_table_visible(id, &first);
+    char* buf = (char*)malloc((size_t)n * 12 + 1);
+    if (!buf) return hajimu_string("");
+    int o = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < n; ++i)
+        o += sprintf(buf + o, i ? ",%d" : "%d", ui_table_row_at(id, first + i));
+    Value v = hajimu_string(buf);
+    free(buf);
+    return v;
+}
+static Value fn_ui_table_cell(int argc, Value* args) {
+    /* id, 列, 行 → 数値 */
+    NEED(3);
+    return hajimu_number(ui_table_get_f64((int)args[0].number,
+                                          (int)args[1].number, (int)args[2].number));
+}
+static Value fn_ui_table_cell_text(int argc, Value* args) {
+    NEED(3);
+    return hajimu_string(ui_table_get_str((int)args[0].number,
+                                          (int)args[1].number, (int)args[2].number));
+}
+static Value fn_ui_table_selected(int argc, Value* args) {
+    NEED(1);
+    return hajimu_number(ui_table_selected((int)args[0].number));
+}
+
+/* ── v1.3.0 ツリー ───────────────────────────────────────*/
+static Value fn_ui_tree_clear(int argc, Value* args) {
+    NEED(1);
+    ui_tree_clear((int)args[0].number);
+    return hajimu_null();
+}
+static Value fn_ui_tree_add(int argc, Value* args) {
+    /* id, 親 (0 = 最上位), ラベル, 子あり → ノード番号 (-1) */
+    NEED(4);
+    return hajimu_number(ui_tree_add((int)args[0].number, (int)args[1].number,
+                                     STR(2), BOOL_(3)));
+}
+static Value fn_ui_tree(int argc, Value* args) {
+    /* id, x, y, w, h, 行高, インデント, ホイール → クリックされたノード (-1) */
+    NEED(8);
+    return hajimu_number(ui_tree((int)args[0].number, NUM(1), NUM(2), NUM(3),
+                                 NUM(4), NUM(5), NUM(6), NUM(7)));
+}
+static Value fn_ui_tree_expand(int argc, Value* args) {
+    NEED(3);
+    ui_tree_expand((int)args[0].number, (int)args[1].number, BOOL_(2));
+    return hajimu_null();
+}
+static Value fn_ui_tree_is_expanded(int argc, Value* args) {
+    NEED(2);
+    return hajimu_bool(ui_tree_is_expanded((int)args[0].number, (int)args[1].number));
+}
+/* 子の読み込みを待つノードを 1 つ返す (-1 = 無し)。スクリプトは UIツリー追加で子を足す。 */
+static Value fn_ui_tree_pending(int argc, Value* args) {
+    NEED(1);
+    return hajimu_number(ui_tree_pending_load((int)args[0].number));
+}
+static Value fn_ui_tree_remove_children(int argc, Value* args) {
+    NEED(2);
+    ui_tree_remove_children((int)args[0].number, (int)args[1].number);
+    return hajimu_null();
+}
+/* 返値: 表示範囲のノード番号 (上から順) の CSV 文字列 */
+static Value fn_ui_tree_visible(int argc, Value* args) {
+    NEED(1);
+    int id = (int)args[0].number, first = 0;
+    int n  = ui_tree_visible(id, &first);
+    char* buf = (char*)malloc((size_t)n * 12 + 1);
+    if (!buf) return hajimu_string("");
+    int o = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < n; ++i)
+        o += sprintf(buf + o, i ? ",%d" : "%d", ui_tree_row_node(id, first + i));
+    Value v = hajimu_string(buf);
+    free(buf);
+    return v;
+}
+static Value fn_ui_tree_first(int argc, Value* args) {
+    NEED(1);
+    int first = 0;
+    ui_tree_visible((int)args[0].number, &first);
+    return hajimu_number(first);
+}
+static Value fn_ui_tree_depth(int argc, Value* args) {
+    NEED(2);
+    return hajimu_number(ui_tree_node_depth((int)args[0].number, (int)args[1].number));
+}
+static Value fn_ui_tree_label(int argc, Value* args) {
+    NEED(2);
+    return hajimu_string(ui_tree_node_label((int)args[0].number, (int)args[1].number));
+}
+static Value fn_ui_tree_has_children(int argc, Value* args) {
+    NEED(2);
+    return hajimu_bool(ui_tree_node_has_children((int)args[0].number,
+                                                 (int)args[1].number));
+}
+static Value fn_ui_tree_selected(int argc, Value* args) {
+    NEED(1);
+    return hajimu_number(ui_tree_selected((int)args[0].number));
+}
+
+/* ── v1.3.0 プロット ─────────────────────────────────────*/
+static Value fn_ui_plot_setup(int argc, Value* args) {
+    /* id, 容量 */
+    NEED(2);
+    return hajimu_bool(ui_plot_setup((int)args[0].number, (int)args[1].number));
+}
+static Value fn_ui_plot_clear(int argc, Value* args) {
+    NEED(1);
+    ui_plot_clear((int)args[0].number);
+    return hajimu_null();
+}
+/* サンプルを "1,2.5,3" 形式の CSV で追加 */
+static Value fn_ui_plot_push(int argc, Value* args) {
+    NEED(2);
+    int id = (int)args[0].number;
+    const char* p = STR(1);
+    if (!p) return hajimu_null();
+    size_t n = 1;
+    for (const char* q = p; *q; ++q) if (*q == ',') n++;
+    float* data = (float*)malloc(sizeof(float) * n);
+    if (!data) return hajimu_null();
+    for (size_t i = 0; i < n; ++i) {
+        char* end;
+        data[i] = strtof(p, &end);
+        p = strchr(end, ',');
+        if (!p) { n = i + 1; break; }
+        p++;
+    }
+    ui_plot_push(id, data, (int)n);
+    free(data);
+    return hajimu_null();
+}
+static Value fn_ui_plot_sample(int argc, Value* args) {
+    /* id, サンプル番号 → 値 */
+    NEED(2);
+    return hajimu_number(ui_plot_sample((int)args[0].number, (int64_t)args[1].number));
+}
+static Value fn_ui_plot_view(int argc, Value* args) {
+    /* id, 先頭番号, 数 */
+    NEED(3);
+    ui_plot_set_view((int)args[0].number, (int64_t)args[1].number,
+                     (int64_t)args[2].number);
+    return hajimu_null();
+}
+static Value fn_ui_plot_follow(int argc, Value* args) {
+    NEED(2);
+    ui_plot_follow((int)args[0].number, (int64_t)args[1].number);
+    return hajimu_null();
+}
+static Value fn_ui_plot_mode(int argc, Value* args) {
+    NEED(2);
+    ui_plot_set_mode((int)args[0].number, (int)args[1].number);
+    return hajimu_null();
+}
+static Value fn_ui_plot_y_range(int argc, Value* args) {
+    NEED(3);
+    ui_plot_set_y_range((int)args[0].number, NUM(1), NUM(2));
+    return hajimu_null();
+}
+static Value fn_ui_plot(int argc, Value* args) {
+    /* id, x, y, w, h, ホイール → ホバー中のサンプル番号 (-1) */
+    NEED(6);
+    return hajimu_number((double)ui_plot((int)args[0].number, NUM(1), NUM(2),
+                                         NUM(3), NUM(4), NUM(5)));
+}
+/* 返値: 点列 "x,y,x,y,..." の CSV 文字列 */
+static Value fn_ui_plot_points(int argc, Value* args) {
+    NEED(1);
+    const UIPlotPoint* pts = NULL;
+    int n = ui_plot_points((int)args[0].number, &pts);
+    size_t cap = (size_t)n * 24 + 1, o = 0;
+    char*  buf = (char*)malloc(cap);
+    if (!buf) return hajimu_string("");
+    buf[0] = '\0';
+    for (int i = 0; i < n; ++i) {
+        /* 座標は ui_plot 側で抑えてあるが、長さは書式結果で確かめて伸ばす */
+        int k = snprintf(buf + o, cap - o, i ? ",%.1f,%.1f" : "%.1f,%.1f",
+                         pts[i].x, pts[i].y);
+        if (k < 0) break;
+        if ((size_t)k >= cap - o) {
+            size_t ncap = (cap + (size_t)k) * 2;
+            char*  nb   = (char*)realloc(buf, ncap);
+            if (!nb) { buf[o] = '\0'; break; }
+            buf = nb;
+            cap = ncap;
+            snprintf(buf + o, cap - o, i ? ",%.1f,%.1f" : "%.1f,%.1f",
+                     pts[i].x, pts[i].y);
+        }
+        o += (size_t)k;
+    }
+    Value v = hajimu_string(buf);
+    free(buf);
+    return v;
+}
+/* 返値: "表示先頭,表示数,Y下限,Y上限,最古番号,総数" の CSV 文字列 */
+static Value fn_ui_plot_state(int argc, Value* args) {
+    NEED(1);
+    int id = (int)args[0].number;
+    int64_t first, count;
+    float lo, hi;
+    ui_plot_get_view(id, &first, &count);
+    ui_plot_get_y_range(id, &lo, &hi);
+    char buf[160];
+    snprintf(buf, sizeof(buf), "%lld,%lld,%g,%g,%lld,%lld",
+             (long long)first, (long long)count, lo, hi,
+             (long long)ui_plot_oldest(id), (long long)ui_plot_total(id));
+    return hajimu_string(buf);
+}
+
 /* ── プラグインテーブル ─────────────────────────────────*/
 static HajimuPluginFunc funcs[] = {
     /* 初期化・更新 */
@@ -219,12 +633,72 @@ static HajimuPluginFunc funcs[] = {
     { "UIスピナー",           fn_ui_spinner,       9, 9 },
     { "UIタブ",               fn_ui_tab,           7, 7 },
     { "UIタブ選択",           fn_ui_tab_selected,  1, 1 },
+    /* v1.3.0 プロファイル */
+    { "UIプロファイル有効",   fn_ui_profile_enable,  1, 1 },
+    { "UIプロファイルリセット", fn_ui_profile_reset, 0, 0 },
+    { "UIプロファイル開始",   fn_ui_profile_begin,   1, 1 },
+    { "UIプロファイル終了",   fn_ui_profile_end,     0, 0 },
+    { "UIプロファイル集計",   fn_ui_profile_summary, 0, 0 },
+    { "UIプロファイル書出",   fn_ui_profile_export,  1, 1 },
+    /* v1.3.0 テキストエリア */
+    { "UIテキストエリア",         fn_ui_textarea,            6, 6 },
+    { "UIテキストエリア設定",     fn_ui_textarea_config,     4, 4 },
+    { "UIテキストエリア代入",     fn_ui_textarea_set_text,   2, 2 },
+    { "UIテキストエリア入力",     fn_ui_textarea_insert,     2, 2 },
+    { "UIテキストエリア後退",     fn_ui_textarea_backspace,  2, 2 },
+    { "UIテキストエリア削除",     fn_ui_textarea_delete,     2, 2 },
+    { "UIテキストエリア移動",     fn_ui_textarea_move,       3, 3 },
+    { "UIテキストエリア取得",     fn_ui_textarea_get_text,   1, 1 },
+    { "UIテキストエリア表示",     fn_ui_textarea_visible,    1, 1 },
+    { "UIテキストエリア先頭行",   fn_ui_textarea_first_line, 1, 1 },
+    { "UIテキストエリア行数",     fn_ui_textarea_line_count, 1, 1 },
+    { "UIテキストエリアキャレット", fn_ui_textarea_caret,    1, 1 },
+    /* v1.3.0 テーブル */
+    { "UIテーブル準備",       fn_ui_table_setup,        3, 3 },
+    { "UIテーブル数値列",     fn_ui_table_column_num,   3, 3 },
+    { "UIテーブル文字列列",   fn_ui_table_column_str,   3, 3 },
+    { "UIテーブルセル数値",   fn_ui_table_cell_num,     4, 4 },
+    { "UIテーブルセル文字列", fn_ui_table_cell_str,     4, 4 },
+    { "UIテーブル列幅",       fn_ui_table_column_width, 3, 3 },
+    { "UIテーブル",           fn_ui_table,              8, 8 },
+    { "UIテーブルソート",     fn_ui_table_sort,         3, 3 },
+    { "UIテーブルソート状態", fn_ui_table_sort_state,   1, 1 },
+    { "UIテーブル表示行",     fn_ui_table_visible,      1, 1 },
+    { "UIテーブルセル",       fn_ui_table_cell,         3, 3 },
+    { "UIテーブルセル文字",   fn_ui_table_cell_text,    3, 3 },
+    { "UIテーブル選択",       fn_ui_table_selected,     1, 1 },
+    /* v1.3.0 ツリー */
+    { "UIツリー準備",         fn_ui_tree_clear,           1, 1 },
+    { "UIツリー追加",         fn_ui_tree_add,             4, 4 },
+    { "UIツリー",             fn_ui_tree,                 8, 8 },
+    { "UIツリー展開",         fn_ui_tree_expand,          3, 3 },
+    { "UIツリー展開中",       fn_ui_tree_is_expanded,     2, 2 },
+    { "UIツリー読込要求",     fn_ui_tree_pending,         1, 1 },
+    { "UIツリー子削除",       fn_ui_tree_remove_children, 2, 2 },
+    { "UIツリー表示行",       fn_ui_tree_visible,         1, 1 },
+    { "UIツリー先頭",         fn_ui_tree_first,           1, 1 },
+    { "UIツリー深さ",         fn_ui_tree_depth,           2, 2 },
+    { "UIツリーラベル",       fn_ui_tree_label,           2, 2 },
+    { "UIツリー子あり",       fn_ui_tree_has_children,    2, 2 },
+    { "UIツリー選択",         fn_ui_tree_selected,        1, 1 },
+    /* v1.3.0 プロット */
+    { "UIプロット準備",       fn_ui_plot_setup,         2, 2 },
+    { "UIプロット消去",       fn_ui_plot_clear,         1, 1 },
+    { "UIプロット追加",       fn_ui_plot_push,          2, 2 },
+    { "UIプロット値",         fn_ui_plot_sample,        2, 2 },
+    { "UIプロット表示範囲",   fn_ui_plot_view,          3, 3 },
+    { "UIプロット追従",       fn_ui_plot_follow,        2, 2 },
+    { "UIプロットモード",     fn_ui_plot_mode,          2, 2 },
+    { "UIプロットY範囲",      fn_ui_plot_y_range,       3, 3 },
+    { "UIプロット",           fn_ui_plot,               6, 6 },
+    { "UIプロット点",         fn_ui_plot_points,        1, 1 },
+    { "UIプロット状態",       fn_ui_plot_state,         1, 1 },
 };
 
 HAJIMU_PLUGIN_EXPORT HajimuPluginInfo* hajimu_plugin_init(void) {
     static HajimuPluginInfo info = {
         .name           = "engine_ui",
-        .version        = "1.2.0",
+        .version        = "1.3.0",
         .functions      = funcs,
         .function_count = sizeof(funcs) / sizeof(funcs[0]),
     };
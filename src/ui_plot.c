@@ -0,0 +1,607 @@
+/**
+ * src/ui_plot.c — プロット (最小/最大の階層キャッシュによる間引き)
+ *
+ * サンプルは 2 の冪容量のリングに通し番号 i → data[i & mask] で置く。
+ * レベル l の要約は 64 * 8^l サンプルごとの最小/最大で、やはり通し番号の
+ * ブロック j → スロット j & mask に置く (スロット数は容量の 2 倍分あるので
+ * 最古と最新のブロックが衝突しない)。要約は点列計算の直前に、前回以降に
+ * 完了したブロックだけを追加で集計する。
+ * 区間 [s, e) の最小/最大は、境界の揃った最大のブロックを貪欲に使い、
+ * 端数だけ生データを SIMD で走査する。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#include "eng_ui.h"
+#include "eng_ui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_PLOT_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UI_PLOT_NEON 1
+#endif
+
+#define UI_MAX_PLOTS        8
+#define UI_PLOT_BLOCK_SHIFT 6    /* レベル 0 のブロック = 64 サンプル */
+#define UI_PLOT_FAN_SHIFT   3    /* 上位レベルは下位 8 ブロック分 */
+#define UI_PLOT_MAX_LEVELS  8
+
+typedef struct {
+    float*  mn;
+    float*  mx;
+    int     shift;     /* ブロック長 = 1 << shift */
+    int64_t mask;      /* スロット数 - 1 */
+    int64_t built;     /* 集計済みとみなす完了ブロック数 (通し番号) */
+} UIPlotLevel;
+
+typedef struct {
+    int64_t k;         /* 列番号 (通し番号 / spp の固定グリッド), -1 = 空き */
+    float   mn, mx;
+    bool    complete;  /* 範囲のサンプルがすべて揃った状態で集計した */
+} UIPlotCol;
+
+typedef struct {
+    int          id;
+    bool         used;
+    /* サンプル */
+    float*       data;
+    int64_t      mask;          /* 容量 - 1 */
+    int64_t      total;         /* 次に書く通し番号 */
+    UIPlotLevel  lv[UI_PLOT_MAX_LEVELS];
+    int          levels;
+    /* 表示設定 */
+    bool         follow;
+    int64_t      first, count;  /* count <= 0 = 全体 */
+    int          mode;
+    float        y_lo, y_hi;    /* lo >= hi = 自動 */
+    /* 直近の矩形と操作 */
+    float        x, y, w, h;
+    bool         dragging;
+    float        drag_x;
+    int64_t      drag_first;
+    /* 列キャッシュ */
+    UIPlotCol*   cols;
+    int          col_cap;
+    double       col_spp;
+    /* 出力 */
+    UIPlotPoint* pts;
+    int          pts_cap, pts_count;
+    float        out_lo, out_hi;
+    bool         dirty;
+} UIPlot;
+
+static UIPlot plots[UI_MAX_PLOTS];
+
+static UIPlot* plot_get(int id) {
+    UIPlot* found = NULL;
+    ui_profile_begin("ui.plot_get");
+    for (int i = 0; i < UI_MAX_PLOTS && !found; ++i)
+        if (plots[i].used && plots[i].id == id) found = &plots[i];
+    for (int i = 0; i < UI_MAX_PLOTS && !found; ++i) {
+        if (!plots[i].used) {
+            memset(&plots[i], 0, sizeof(UIPlot));
+            plots[i].id     = id;
+            plots[i].used   = true;
+            plots[i].follow = true;
+            plots[i].dirty  = true;
+            found = &plots[i];
+        }
+    }
+    ui_profile_end();
+    return found;
+}
+
+static void plot_free(UIPlot* p) {
+    free(p->data);
+    for (int l = 0; l < UI_PLOT_MAX_LEVELS; ++l) { free(p->lv[l].mn); free(p->lv[l].mx); }
+    free(p->cols);
+    free(p->pts);
+}
+
+void ui_plot_reset_all(void) {
+    for (int i = 0; i < UI_MAX_PLOTS; ++i) {
+        if (plots[i].used) plot_free(&plots[i]);
+        memset(&plots[i], 0, sizeof(UIPlot));
+    }
+}
+
+static int64_t oldest_of(const UIPlot* p) {
+    int64_t cap = p->mask + 1;
+    return p->total > cap ? p->total - cap : 0;
+}
+
+static void cols_invalidate(UIPlot* p) {
+    for (int i = 0; i < p->col_cap; ++i) p->cols[i].k = -1;
+}
+
+/* ── SIMD 最小/最大 ─────────────────────────────────────*/
+
+/* v[0..n) の最小/最大を *mn / *mx に畳み込む */
+static void minmax_f32(const float* v, int64_t n, float* mn, float* mx) {
+    float lo = *mn, hi = *mx;
+    int64_t i = 0;
+#if defined(UI_PLOT_SSE2)
+    if (n >= 8) {
+        __m128 l0 = _mm_loadu_ps(v), l1 = _mm_loadu_ps(v + 4);
+        __m128 h0 = l0, h1 = l1;
+        for (i = 8; i + 8 <= n; i += 8) {
+            __m128 a = _mm_loadu_ps(v + i), b = _mm_loadu_ps(v + i + 4);
+            l0 = _mm_min_ps(l0, a); l1 = _mm_min_ps(l1, b);
+            h0 = _mm_max_ps(h0, a); h1 = _mm_max_ps(h1, b);
+        }
+        l0 = _mm_min_ps(l0, l1);
+        h0 = _mm_max_ps(h0, h1);
+        l0 = _mm_min_ps(l0, _mm_shuffle_ps(l0, l0, _MM_SHUFFLE(1, 0, 3, 2)));
+        h0 = _mm_max_ps(h0, _mm_shuffle_ps(h0, h0, _MM_SHUFFLE(1, 0, 3, 2)));
+        l0 = _mm_min_ps(l0, _mm_shuffle_ps(l0, l0, _MM_SHUFFLE(2, 3, 0, 1)));
+        h0 = _mm_max_ps(h0, _mm_shuffle_ps(h0, h0, _MM_SHUFFLE(2, 3, 0, 1)));
+        float a = _mm_cvtss_f32(l0), b = _mm_cvtss_f32(h0);
+        if (a < lo) lo = a;
+        if (b > hi) hi = b;
+    }
+#elif defined(UI_PLOT_NEON)
+    if (n >= 8) {
+        float32x4_t l0 = vld1q_f32(v), l1 = vld1q_f32(v + 4);
+        float32x4_t h0 = l0, h1 = l1;
+        for (i = 8; i + 8 <= n; i += 8) {
+            float32x4_t a = vld1q_f32(v + i), b = vld1q_f32(v + i + 4);
+            l0 = vminq_f32(l0, a); l1 = vminq_f32(l1, b);
+            h0 = vmaxq_f32(h0, a); h1 = vmaxq_f32(h1, b);
+        }
+        l0 = vminq_f32(l0, l1);
+        h0 = vmaxq_f32(h0, h1);
+        float32x2_t l2 = vpmin_f32(vget_low_f32(l0), vget_high_f32(l0));
+        float32x2_t h2 = vpmax_f32(vget_low_f32(h0), vget_high_f32(h0));
+        l2 = vpmin_f32(l2, l2);
+        h2 = vpmax_f32(h2, h2);
+        float a = vget_lane_f32(l2, 0), b = vget_lane_f32(h2, 0);
+        if (a < lo) lo = a;
+        if (b > hi) hi = b;
+    }
+#endif
+    for (; i < n; ++i) {
+        if (v[i] < lo) lo = v[i];
+        if (v[i] > hi) hi = v[i];
+    }
+    *mn = lo;
+    *mx = hi;
+}
+
+/* 通し番号 [s, e) の生データを走査 (リングの折り返しを分割) */
+static void raw_minmax(const UIPlot* p, int64_t s, int64_t e, float* mn, float* mx) {
+    int64_t cap = p->mask + 1;
+    while (s < e) {
+        int64_t slot = s & p->mask;
+        int64_t n    = e - s;
+        if (n > cap - slot) n = cap - slot;
+        minmax_f32(p->data + slot, n, mn, mx);
+        s += n;
+    }
+}
+
+/* ── 階層キャッシュ ──────────────────────────────────────*/
+static void levels_build(UIPlot* p) {
+    ui_profile_begin("ui.plot_levels");
+    int64_t oldest = oldest_of(p);
+    for (int l = 0; l < p->levels; ++l) {
+        UIPlotLevel* L = &p->lv[l];
+        int64_t done  = p->total >> L->shift;
+        int64_t first = (oldest + ((int64_t)1 << L->shift) - 1) >> L->shift;
+        int64_t j     = L->built > first ? L->built : first;
+        for (; j < done; ++j) {
+            float mn = INFINITY, mx = -INFINITY;
+            if (l == 0) {
+                minmax_f32(p->data + ((j << L->shift) & p->mask),
+                           (int64_t)1 << L->shift, &mn, &mx);
+            } else {
+                /* 子 8 ブロックはスロットも連続している */
+                const UIPlotLevel* C = &p->lv[l - 1];
+                int64_t c0 = (j << UI_PLOT_FAN_SHIFT) & C->mask;
+                float dummy_hi = -INFINITY, dummy_lo = INFINITY;
+                minmax_f32(C->mn + c0, 1 << UI_PLOT_FAN_SHIFT, &mn, &dummy_hi);
+                minmax_f32(C->mx + c0, 1 << UI_PLOT_FAN_SHIFT, &dummy_lo, &mx);
+            }
+            L->mn[j & L->mask] = mn;
+            L->mx[j & L->mask] = mx;
+        }
+        if (done > L->built) L->built = done;
+    }
+    ui_profile_end();
+}
+
+/* 通し番号 [s, e) の最小/最大 (保持範囲内・要約は構築済みであること) */
+static void range_minmax(const UIPlot* p, int64_t s, int64_t e, float* mn, float* mx) {
+    int64_t base = (int64_t)1 << UI_PLOT_BLOCK_SHIFT;
+    while (s < e) {
+        int l = p->levels - 1;
+        for (; l >= 0; --l) {
+            const UIPlotLevel* L = &p->lv[l];
+            int64_t len = (int64_t)1 << L->shift;
+            if ((s & (len - 1)) == 0 && s + len <= e) {
+                int64_t slot = (s >> L->shift) & L->mask;
+                if (L->mn[slot] < *mn) *mn = L->mn[slot];
+                if (L->mx[slot] > *mx) *mx = L->mx[slot];
+                s += len;
+                break;
+            }
+        }
+        if (l < 0) {
+            /* 次のレベル 0 境界までは生データ */
+            int64_t nxt = (s | (base - 1)) + 1;
+            if (nxt > e) nxt = e;
+            raw_minmax(p, s, nxt, mn, mx);
+            s = nxt;
+        }
+    }
+}
+
+/* ── データ ─────────────────────────────────────────────*/
+bool ui_plot_setup(int id, int capacity) {
+    UIPlot* p = plot_get(id);
+    if (!p) return false;
+    int64_t cap = (int64_t)1 << UI_PLOT_BLOCK_SHIFT;
+    while (cap < capacity) cap <<= 1;
+
+    plot_free(p);
+    p->data = NULL;
+    memset(p->lv, 0, sizeof(p->lv));
+    p->cols = NULL; p->col_cap = 0;
+    p->pts  = NULL; p->pts_cap = 0; p->pts_count = 0;
+    p->mask = 0; p->total = 0; p->levels = 0;
+    p->dirty = true;
+
+    p->data = (float*)malloc(sizeof(float) * (size_t)cap);
+    if (!p->data) return false;
+    /* 最上位はブロック長が容量を超えない範囲まで */
+    for (int l = 0, shift = UI_PLOT_BLOCK_SHIFT;
+         l < UI_PLOT_MAX_LEVELS && ((int64_t)1 << shift) <= cap;
+         ++l, shift += UI_PLOT_FAN_SHIFT) {
+        UIPlotLevel* L = &p->lv[l];
+        int64_t slots = (cap >> shift) * 2;
+        L->mn = (float*)malloc(sizeof(float) * (size_t)slots);
+        L->mx = (float*)malloc(sizeof(float) * (size_t)slots);
+        if (!L->mn || !L->mx) {
+            plot_free(p);
+            memset(p->lv, 0, sizeof(p->lv));
+            p->data = NULL;
+            return false;
+        }
+        L->shift = shift;
+        L->mask  = slots - 1;
+        p->levels = l + 1;
+    }
+    p->mask = cap - 1;
+    return true;
+}
+
+void ui_plot_clear(int id) {
+    UIPlot* p = plot_get(id);
+    if (!p) return;
+    p->total = 0;
+    for (int l = 0; l < p->levels; ++l) p->lv[l].built = 0;
+    cols_invalidate(p);
+    p->dirty = true;
+}
+
+void ui_plot_push(int id, const float* values, int n) {
+    UIPlot* p = plot_get(id);
+    if (!p || !p->data || !values || n <= 0) return;
+    int64_t cap = p->mask + 1;
+    if (n > cap) {                      /* 残るのは末尾の cap 個だけ */
+        p->total += n - cap;
+        values   += n - cap;
+        n = (int)cap;
+    }
+    while (n > 0) {
+        int64_t slot = p->total & p->mask;
+        int64_t k    = n;
+        if (k > cap - slot) k = cap - slot;
+        memcpy(p->data + slot, values, sizeof(float) * (size_t)k);
+        values   += k;
+        n        -= (int)k;
+        p->total += k;
+    }
+    p->dirty = true;
+}
+
+int64_t ui_plot_total(int id) {
+    UIPlot* p = plot_get(id);
+    return p ? p->total : 0;
+}
+
+int64_t ui_plot_oldest(int id) {
+    UIPlot* p = plot_get(id);
+    return p ? oldest_of(p) : 0;
+}
+
+float ui_plot_sample(int id, int64_t index) {
+    UIPlot* p = plot_get(id);
+    if (!p || !p->data || index < oldest_of(p) || index >= p->total) return 0.0f;
+    return p->data[index & p->mask];
+}
+
+/* ── 表示設定 ───────────────────────────────────────────*/
+void ui_plot_set_view(int id, int64_t first, int64_t count) {
+    UIPlot* p = plot_get(id);
+    if (!p) return;
+    p->follow = false;
+    p->first  = first;
+    p->count  = count;
+    p->dirty  = true;
+}
+
+void ui_plot_follow(int id, int64_t count) {
+    UIPlot* p = plot_get(id);
+    if (!p) return;
+    p->follow = true;
+    p->count  = count;
+    p->dirty  = true;
+}
+
+/* 保持範囲にクランプした表示範囲 */
+static void resolve_view(const UIPlot* p, int64_t* first, int64_t* count) {
+    int64_t lo = oldest_of(p), avail = p->total - lo;
+    int64_t n  = (p->count > 0 && p->count < avail) ? p->count : avail;
+    int64_t a  = p->follow ? p->total - n : p->first;
+    if (a > p->total - n) a = p->total - n;
+    if (a < lo) a = lo;
+    *first = a;
+    *count = n;
+}
+
+void ui_plot_get_view(int id, int64_t* first, int64_t* count) {
+    UIPlot* p = plot_get(id);
+    int64_t a = 0, n = 0;
+    if (p) resolve_view(p, &a, &n);
+    if (first) *first = a;
+    if (count) *count = n;
+}
+
+void ui_plot_set_mode(int id, int mode) {
+    UIPlot* p = plot_get(id);
+    if (!p) return;
+    p->mode  = mode == UI_PLOT_LTTB ? UI_PLOT_LTTB : UI_PLOT_MINMAX;
+    p->dirty = true;
+}
+
+void ui_plot_set_y_range(int id, float lo, float hi) {
+    UIPlot* p = plot_get(id);
+    if (!p) return;
+    p->y_lo  = lo;
+    p->y_hi  = hi;
+    p->dirty = true;
+}
+
+void ui_plot_get_y_range(int id, float* lo, float* hi) {
+    UIPlot* p = plot_get(id);
+    if (lo) *lo = p ? p->out_lo : 0.0f;
+    if (hi) *hi = p ? p->out_hi : 0.0f;
+}
+
+/* ── 間引き ─────────────────────────────────────────────*/
+static bool pts_reserve(UIPlot* p, int n) {
+    if (n <= p->pts_cap) return true;
+    UIPlotPoint* np = (UIPlotPoint*)realloc(p->pts, sizeof(UIPlotPoint) * (size_t)n);
+    if (!np) return false;
+    p->pts     = np;
+    p->pts_cap = n;
+    return true;
+}
+
+/* 列 k の先頭サンプル番号 (列 k は [col_start(k), col_start(k+1))) */
+static int64_t col_start(int64_t k, double spp) {
+    return (int64_t)floor((double)k * spp);
+}
+
+/* 列 k を (キャッシュになければ) 集計する。範囲が空なら mn > mx のまま */
+static const UIPlotCol* column(UIPlot* p, int64_t k, double spp, int64_t oldest) {
+    UIPlotCol* c = &p->cols[k % p->col_cap];
+    int64_t s = col_start(k, spp);
+    int64_t e = col_start(k + 1, spp);
+    if (c->k == k && c->complete && s >= oldest) return c;
+    bool complete = s >= oldest && e <= p->total;
+    if (s < oldest)   s = oldest;
+    if (e > p->total) e = p->total;
+    c->k  = k;
+    c->mn = INFINITY;
+    c->mx = -INFINITY;
+    range_minmax(p, s, e, &c->mn, &c->mx);
+    c->complete = complete;
+    return c;
+}
+
+/* 手動の Y 範囲から大きく外れた値は矩形の上下 1 枚分までに抑える
+ * (線の向きは保ちつつ、座標が巨大値や inf/NaN にならないように) */
+static float to_screen_y(const UIPlot* p, float v) {
+    float sy = p->y + p->h - (v - p->out_lo) / (p->out_hi - p->out_lo) * p->h;
+    if (!(sy >= p->y - p->h))       sy = p->y - p->h;
+    if (!(sy <= p->y + 2.0f * p->h)) sy = p->y + 2.0f * p->h;
+    return sy;
+}
+
+static void decimate(UIPlot* p) {
+    p->dirty     = false;
+    p->pts_count = 0;
+    int64_t a, n;
+    resolve_view(p, &a, &n);
+    int W = (int)p->w;
+    if (!p->data || n <= 0 || W <= 0) return;
+
+    ui_profile_begin("ui.plot_decimate");
+    bool  auto_y = !(p->y_lo < p->y_hi);
+    float lo = INFINITY, hi = -INFINITY;
+
+    if (n <= W) {
+        /* 幅以下なら生サンプルを 1 点ずつ */
+        if (pts_reserve(p, (int)n)) {
+            if (auto_y) raw_minmax(p, a, a + n, &lo, &hi);
+            else        { lo = p->y_lo; hi = p->y_hi; }
+            if (!(hi > lo)) { lo -= 0.5f; hi += 0.5f; }
+            p->out_lo = lo;
+            p->out_hi = hi;
+            for (int64_t i = 0; i < n; ++i) {
+                UIPlotPoint* q = &p->pts[i];
+                q->x = p->x + ((float)i + 0.5f) * p->w / (float)n;
+                q->y = to_screen_y(p, p->data[(a + i) & p->mask]);
+            }
+            p->pts_count = (int)n;
+        }
+        ui_profile_end();
+        return;
+    }
+
+    levels_build(p);
+    /* 列はサンプル番号 k*spp の固定グリッド。spp が変わらない限り再利用できる */
+    double  spp    = (double)n / (double)W;
+    int64_t k0     = (int64_t)floor((double)a / spp);
+    int64_t k1     = (int64_t)ceil((double)(a + n) / spp);
+    /* 浮動小数の丸めで端の列が [a, a+n) から外れることがあるので、
+     * col_start と同じ式で両端が表示範囲に重なるよう詰める */
+    while (col_start(k0, spp) > a) k0--;
+    while (col_start(k0 + 1, spp) <= a) k0++;
+    while (col_start(k1, spp) < a + n) k1++;
+    while (col_start(k1 - 1, spp) >= a + n) k1--;
+    int     ncols  = (int)(k1 - k0);
+    int64_t oldest = oldest_of(p);
+    if (p->col_cap < ncols + 2) {
+        UIPlotCol* nc = (UIPlotCol*)realloc(p->cols, sizeof(UIPlotCol) * (size_t)(ncols + 2));
+        if (!nc) { ui_profile_end(); return; }
+        p->cols    = nc;
+        p->col_cap = ncols + 2;
+        cols_invalidate(p);
+    }
+    if (spp != p->col_spp) { cols_invalidate(p); p->col_spp = spp; }
+
+    for (int64_t k = k0; k < k1; ++k) {
+        const UIPlotCol* c = column(p, k, spp, oldest);
+        if (c->mn > c->mx) continue;
+        if (c->mn < lo) lo = c->mn;
+        if (c->mx > hi) hi = c->mx;
+    }
+    if (!auto_y) { lo = p->y_lo; hi = p->y_hi; }
+    if (!(hi > lo)) { lo -= 0.5f; hi += 0.5f; }
+    p->out_lo = lo;
+    p->out_hi = hi;
+
+    if (!pts_reserve(p, ncols * 2)) { ui_profile_end(); return; }
+    float x_off = p->x - (float)((double)a / spp - (double)k0);
+    float prev_y = NAN;
+    int   m = 0;
+    for (int i = 0; i < ncols; ++i) {
+        const UIPlotCol* c = &p->cols[(k0 + i) % p->col_cap];
+        if (c->mn > c->mx) continue;        /* 保持範囲外で空になった列 */
+        float cx = x_off + (float)i + 0.5f;
+        if (cx < p->x) cx = p->x;
+        if (cx > p->x + p->w) cx = p->x + p->w;
+        float ymn = to_screen_y(p, c->mn), ymx = to_screen_y(p, c->mx);
+        if (p->mode == UI_PLOT_LTTB) {
+            /* MinMax 候補から、前の選択点と次の列の平均とで作る三角形が
+             * 最大になる方を選ぶ (MinMaxLTTB) */
+            float ax = m ? p->pts[m - 1].x : cx - 1.0f;
+            float ay = m ? p->pts[m - 1].y : (ymn + ymx) * 0.5f;
+            float nx = cx + 1.0f, ny = (ymn + ymx) * 0.5f;
+            if (i + 1 < ncols) {
+                const UIPlotCol* d = &p->cols[(k0 + i + 1) % p->col_cap];
+                if (d->mn <= d->mx)
+                    ny = (to_screen_y(p, d->mn) + to_screen_y(p, d->mx)) * 0.5f;
+            }
+            float area_mn = fabsf((ax - nx) * (ymn - ay) - (ax - cx) * (ny - ay));
+            float area_mx = fabsf((ax - nx) * (ymx - ay) - (ax - cx) * (ny - ay));
+            p->pts[m].x = cx;
+            p->pts[m].y = area_mx > area_mn ? ymx : ymn;
+            m++;
+        } else {
+            /* 前の点に近い方から描くと列間の線が短くなる */
+            bool mn_first = isnan(prev_y) || fabsf(ymn - prev_y) <= fabsf(ymx - prev_y);
+            p->pts[m].x = cx; p->pts[m].y = mn_first ? ymn : ymx; m++;
+            p->pts[m].x = cx; p->pts[m].y = mn_first ? ymx : ymn; m++;
+            prev_y = p->pts[m - 1].y;
+        }
+    }
+    p->pts_count = m;
+    ui_profile_end();
+}
+
+/* ── ウィジェット ────────────────────────────────────────*/
+int64_t ui_plot(int id, float x, float y, float w, float h, float wheel_dy) {
+    UIPlot* p = plot_get(id);
+    if (!p) return -1;
+    if (x != p->x || y != p->y || w != p->w || h != p->h) p->dirty = true;
+    p->x = x; p->y = y; p->w = w; p->h = h;
+    if (!p->data || w <= 0.0f || h <= 0.0f) return -1;
+
+    float mx, my;
+    bool  is_down;
+    ui_mouse_state(&mx, &my, &is_down, NULL);
+    int64_t a, n;
+    resolve_view(p, &a, &n);
+    bool hover = ui_hover(x, y, w, h);
+
+    /* ズーム: カーソル下のサンプルを固定して表示数を変える */
+    if (wheel_dy != 0.0f && hover && n > 0) {
+        double t      = (double)(mx - x) / (double)w;
+        double anchor = (double)a + t * (double)n;
+        int64_t nn    = (int64_t)llround((double)n * pow(0.8, (double)wheel_dy));
+        if (nn < 2) nn = 2;
+        if (nn == n && wheel_dy > 0.0f && n > 2) nn = n - 1;
+        p->count = nn;
+        if (!p->follow) p->first = (int64_t)llround(anchor - t * (double)nn);
+        p->dirty = true;
+        resolve_view(p, &a, &n);
+    }
+
+    /* パン: ドラッグ開始時の表示先頭からの移動量 */
+    if (ui_click(x, y, w, h)) {
+        p->dragging   = true;
+        p->drag_x     = mx;
+        p->drag_first = a;
+    }
+    if (p->dragging) {
+        if (!is_down) {
+            p->dragging = false;
+        } else if (mx != p->drag_x) {
+            int64_t nf = p->drag_first -
+                         (int64_t)llround((double)(mx - p->drag_x) / (double)w * (double)n);
+            if (p->follow || nf != p->first) {
+                p->follow = false;
+                p->first  = nf;
+                p->count  = n;
+                p->dirty  = true;
+                resolve_view(p, &a, &n);
+            }
+        }
+    }
+
+    if (p->dirty) decimate(p);
+    if (!hover || n <= 0) return -1;
+
+    /* ホバー: カーソル列のサンプルのうち、値がカーソルの高さに最も近いもの */
+    double  t0 = (double)(mx - x) / (double)w;
+    double  t1 = (double)(mx + 1.0f - x) / (double)w;
+    int64_t s  = a + (int64_t)floor(t0 * (double)n);
+    int64_t e  = a + (int64_t)floor(t1 * (double)n);
+    if (s < a) s = a;
+    if (s > a + n - 1) s = a + n - 1;
+    if (e <= s) e = s + 1;
+    if (e > a + n) e = a + n;
+    float   target = p->out_lo + (y + h - my) / h * (p->out_hi - p->out_lo);
+    int64_t best   = s;
+    float   best_d = INFINITY;
+    for (int64_t i = s; i < e; ++i) {
+        float d = fabsf(p->data[i & p->mask] - target);
+        if (d < best_d) { best_d = d; best = i; }
+    }
+    return best;
+}
+
+int ui_plot_points(int id, const UIPlotPoint** pts) {
+    UIPlot* p = plot_get(id);
+    if (!p) { if (pts) *pts = NULL; return 0; }
+    if (p->dirty) decimate(p);
+    if (pts) *pts = p->pts;
+    return p->pts_count;
+}
@@ -0,0 +1,224 @@
+/**
+ * src/ui_profile.c — UI プロファイルゾーン (Chrome trace 出力)
+ *
+ * ui_profile_begin/end で囲んだ区間を固定長リングバッファに記録する。
+ * 記録中は malloc を一切行わない (ゾーン名も固定長テーブルに複製)。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "eng_ui.h"
+#include <string.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* ── 固定長バッファ ──────────────────────────────────────*/
+#define UI_PROFILE_MAX_EVENTS 8192   /* リングに残す完了ゾーン数 */
+#define UI_PROFILE_MAX_DEPTH  32
+#define UI_PROFILE_MAX_NAMES  64
+#define UI_PROFILE_NAME_LEN   32
+
+typedef struct {
+    uint64_t start_ns;   /* リセット時刻からの相対 */
+    uint64_t dur_ns;
+    uint16_t name;
+    uint16_t depth;
+} UIProfileEvent;
+
+typedef struct {
+    char        name[UI_PROFILE_NAME_LEN];
+    uint64_t    count;
+    uint64_t    total_ns, min_ns, max_ns;
+} UIProfileName;
+
+static struct {
+    bool           enabled;
+    uint64_t       base_ns;
+    UIProfileEvent events[UI_PROFILE_MAX_EVENTS];
+    uint32_t       head;      /* 次に書く位置 */
+    uint32_t       count;     /* 有効イベント数 (<= MAX_EVENTS) */
+    struct { uint16_t name; uint64_t start_ns; } stack[UI_PROFILE_MAX_DEPTH];
+    int            depth;     /* 記録中の段数 */
+    int            overflow;  /* MAX_DEPTH を超えて無視した begin の数 */
+    UIProfileName  names[UI_PROFILE_MAX_NAMES];
+    int            name_count;
+} p;
+
+/* ── 単調増加クロック (ns) ───────────────────────────────*/
+static uint64_t now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    return (uint64_t)((double)c.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* テーブルに格納する長さ (UTF-8 の文字境界で NAME_LEN-1 バイト以内) */
+static size_t stored_len(const char* name) {
+    size_t len = 0;
+    while (len < UI_PROFILE_NAME_LEN - 1 && name[len]) len++;
+    if (name[len])
+        while (len > 0 && ((unsigned char)name[len] & 0xC0) == 0x80) len--;
+    return len;
+}
+
+/* 名前をテーブルに登録しインデックスを返す。満杯なら最終スロットに集約。 */
+static uint16_t name_index(const char* name) {
+    if (!name) name = "?";
+    size_t len = stored_len(name);
+    for (int i = 0; i < p.name_count; ++i)
+        if (memcmp(p.names[i].name, name, len) == 0 && p.names[i].name[len] == '\0')
+            return (uint16_t)i;
+    if (p.name_count == UI_PROFILE_MAX_NAMES - 1) {
+        UIProfileName* o = &p.names[UI_PROFILE_MAX_NAMES - 1];
+        if (!o->name[0]) strcpy(o->name, "(その他)");
+        return UI_PROFILE_MAX_NAMES - 1;
+    }
+    UIProfileName* n = &p.names[p.name_count];
+    memcpy(n->name, name, len);
+    n->name[len] = '\0';
+    return (uint16_t)p.name_count++;
+}
+
+/* ── 記録 ───────────────────────────────────────────────*/
+void ui_profile_enable(bool enabled) {
+    if (enabled == p.enabled) return;
+    if (enabled && p.base_ns == 0) p.base_ns = now_ns();
+    /* 切り替え前に開いていたゾーンの end は対応が取れないので捨てる */
+    p.depth    = 0;
+    p.overflow = 0;
+    p.enabled  = enabled;
+}
+
+bool ui_profile_enabled(void) { return p.enabled; }
+
+void ui_profile_reset(void) {
+    bool en = p.enabled;
+    memset(&p, 0, sizeof(p));
+    p.enabled = en;
+    p.base_ns = now_ns();
+}
+
+void ui_profile_begin(const char* name) {
+    if (!p.enabled) return;
+    if (p.depth >= UI_PROFILE_MAX_DEPTH) { p.overflow++; return; }
+    p.stack[p.depth].name     = name_index(name);
+    p.stack[p.depth].start_ns = now_ns();
+    p.depth++;
+}
+
+void ui_profile_end(void) {
+    if (!p.enabled) return;
+    if (p.overflow > 0) { p.overflow--; return; }
+    if (p.depth == 0) return;            /* 対応する begin が無い */
+    uint64_t t = now_ns();
+    p.depth--;
+    uint16_t ni    = p.stack[p.depth].name;
+    uint64_t start = p.stack[p.depth].start_ns;
+    uint64_t dur   = t - start;
+
+    UIProfileEvent* e = &p.events[p.head];
+    e->start_ns = start - p.base_ns;
+    e->dur_ns   = dur;
+    e->name     = ni;
+    e->depth    = (uint16_t)p.depth;
+    p.head = (p.head + 1) % UI_PROFILE_MAX_EVENTS;
+    if (p.count < UI_PROFILE_MAX_EVENTS) p.count++;
+
+    UIProfileName* n = &p.names[ni];
+    if (n->count == 0 || dur < n->min_ns) n->min_ns = dur;
+    if (dur > n->max_ns) n->max_ns = dur;
+    n->total_ns += dur;
+    n->count++;
+}
+
+/* ── 集計 ───────────────────────────────────────────────*/
+int ui_profile_zone_count(void) {
+    int n = p.name_count;
+    if (p.names[UI_PROFILE_MAX_NAMES - 1].count) n++;
+    return n;
+}
+
+bool ui_profile_zone_stats(int index, UIProfileZoneStats* out) {
+    if (!out || index < 0 || index >= ui_profile_zone_count()) return false;
+    if (index == p.name_count) index = UI_PROFILE_MAX_NAMES - 1;
+    const UIProfileName* n = &p.names[index];
+    out->name   = n->name;
+    out->count  = n->count;
+    out->min_us = n->count ? (double)n->min_ns * 1e-3 : 0.0;
+    out->max_us = (double)n->max_ns * 1e-3;
+    out->avg_us = n->count ? (double)n->total_ns * 1e-3 / (double)n->count : 0.0;
+    out->total_us = (double)n->total_ns * 1e-3;
+    return true;
+}
+
+/* ゾーン名を RFC 4180 の引用符付きフィールドで書く ('"' は "" に)。
+ * 名前は最大 31 バイトなので、最悪でも 2*31+2 バイトに収まる。 */
+static void csv_field(char* out, const char* s) {
+    *out++ = '"';
+    for (; *s; ++s) {
+        if (*s == '"') *out++ = '"';
+        *out++ = *s;
+    }
+    *out++ = '"';
+    *out   = '\0';
+}
+
+int ui_profile_summary(char* buf, int size) {
+    if (!buf || size <= 0) return 0;
+    int o = snprintf(buf, (size_t)size, "zone,count,min_us,avg_us,max_us,total_us\n");
+    for (int i = 0; i < ui_profile_zone_count() && o < size; ++i) {
+        UIProfileZoneStats st;
+        char name[UI_PROFILE_NAME_LEN * 2 + 2];
+        ui_profile_zone_stats(i, &st);
+        csv_field(name, st.name);
+        o += snprintf(buf + o, (size_t)(size - o), "%s,%llu,%.3f,%.3f,%.3f,%.3f\n",
+                      name, (unsigned long long)st.count,
+                      st.min_us, st.avg_us, st.max_us, st.total_us);
+    }
+    return o < size ? o : size - 1;
+}
+
+/* ── Chrome trace-event JSON ────────────────────────────*/
+static void json_str(FILE* fp, const char* s) {
+    fputc('"', fp);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') { fputc('\\', fp); fputc(c, fp); }
+        else if (c < 0x20)        fprintf(fp, "\\u%04x", c);
+        else                      fputc(c, fp);
+    }
+    fputc('"', fp);
+}
+
+bool ui_profile_export_chrome(const char* path) {
+    if (!path) return false;
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return false;
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", fp);
+    uint32_t first = (p.head + UI_PROFILE_MAX_EVENTS - p.count) % UI_PROFILE_MAX_EVENTS;
+    for (uint32_t i = 0; i < p.count; ++i) {
+        const UIProfileEvent* e = &p.events[(first + i) % UI_PROFILE_MAX_EVENTS];
+        fputs("{\"name\":", fp);
+        json_str(fp, p.names[e->name].name);
+        fprintf(fp, ",\"cat\":\"ui\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                    "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}%s\n",
+                (double)e->start_ns * 1e-3, (double)e->dur_ns * 1e-3,
+                (unsigned)e->depth, i + 1 < p.count ? "," : "");
+    }
+    fputs("]}\n", fp);
+    return fclose(fp) == 0;
+}
@@ -0,0 +1,532 @@
+/**
+ * src/ui_raster.c — ヘッドレス CPU ラスタライザ実装
+ *
+ * ピクセル演算はスカラー / SSE2 / NEON で同じ整数式を使うため、
+ * どの環境で描いても出力はビット単位で一致する (ゴールデン比較用)。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "ui_raster.h"
+#include "eng_ui.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_RASTER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UI_RASTER_NEON 1
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* ── 内部構造 ────────────────────────────────────────────*/
+#define UI_RASTER_CLIP_DEPTH 16
+
+typedef struct { int x0, y0, x1, y1; } IRect;   /* 半開区間 [x0,x1)×[y0,y1) */
+
+struct UIRaster {
+    int      width, height;
+    uint8_t* pixels;
+    IRect    clip[UI_RASTER_CLIP_DEPTH];
+    int      clip_top;
+    int      clip_overflow;   /* CLIP_DEPTH を超えて無視した push の数 */
+    UIRasterStats stats;
+    double   frame_t0;        /* begin_frame の時刻 (0 = フレーム外) */
+};
+
+/* ── デフォルトテーマ (examples/hello_ui.jp の配色) ─────*/
+static const float TH_TRACK[4]    = { 60/255.f,  60/255.f,  80/255.f, 1.0f };
+static const float TH_FILL[4]     = {100/255.f, 160/255.f, 255/255.f, 1.0f };
+static const float TH_KNOB[4]     = {255/255.f, 220/255.f,  80/255.f, 1.0f };
+static const float TH_BAR_BG[4]   = { 40/255.f,  40/255.f,  40/255.f, 1.0f };
+static const float TH_PANEL[4]    = { 80/255.f,  80/255.f, 120/255.f, 1.0f };
+static const float TH_BORDER[4]   = {200/255.f, 200/255.f, 200/255.f, 1.0f };
+static const float TH_HILITE[4]   = {255/255.f, 255/255.f, 255/255.f, 0.25f};
+
+/* ── ヘルパー ────────────────────────────────────────────*/
+static double now_sec(void) {
+#ifdef _WIN32
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static uint8_t to_u8(float v) {
+    if (!(v > 0.0f)) return 0;          /* NaN も 0 */
+    if (v >= 1.0f) return 255;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+/* v を整数境界 [lo, hi] に収めてから四捨五入する (int 変換の範囲外・NaN を防ぐ) */
+static int round_px(float v, int lo, int hi) {
+    if (v < (float)lo) return lo;
+    if (v > (float)hi) return hi;
+    return (int)floorf(v + 0.5f);
+}
+
+static IRect clip_rect(const UIRaster* r, float x, float y, float w, float h) {
+    const IRect* c = &r->clip[r->clip_top];
+    float x1 = x + w, y1 = y + h;
+    IRect o = { c->x0, c->y0, c->x0, c->y0 };     /* NaN を含む矩形は空 */
+    if (isnan(x) || isnan(y) || isnan(x1) || isnan(y1)) return o;
+    /* クリップ境界は整数なので、先に収めても四捨五入後に収めても結果は同じ */
+    o.x0 = round_px(x,  c->x0, c->x1);
+    o.y0 = round_px(y,  c->y0, c->y1);
+    o.x1 = round_px(x1, c->x0, c->x1);
+    o.y1 = round_px(y1, c->y0, c->y1);
+    return o;
+}
+
+/* (x + 128 + ((x + 128) >> 8)) >> 8 = round(x / 255)  (x <= 255*255) */
+static inline uint8_t div255(unsigned x) {
+    x += 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+/* ── スパン処理 (SIMD) ───────────────────────────────────*/
+
+/* n ピクセルを 32bit 値 px (メモリ上 RGBA 順) で塗る */
+static void span_fill(uint8_t* dst, int n, uint32_t px) {
+    int i = 0;
+#if defined(UI_RASTER_SSE2)
+    __m128i v = _mm_set1_epi32((int)px);
+    for (; i + 16 <= n; i += 16) {
+        _mm_storeu_si128((__m128i*)(dst + i*4),      v);
+        _mm_storeu_si128((__m128i*)(dst + i*4 + 16), v);
+        _mm_storeu_si128((__m128i*)(dst + i*4 + 32), v);
+        _mm_storeu_si128((__m128i*)(dst + i*4 + 48), v);
+    }
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i*)(dst + i*4), v);
+#elif defined(UI_RASTER_NEON)
+    uint32x4_t v = vdupq_n_u32(px);
+    for (; i + 4 <= n; i += 4)
+        vst1q_u8(dst + i*4, vreinterpretq_u8_u32(v));
+#endif
+    for (; i < n; ++i) memcpy(dst + i*4, &px, 4);
+}
+
+/*
+ * n ピクセルに src (RGBA, A=255 に置き換えた値) を不透明度 a でブレンド。
+ * 各チャンネル out = div255(src*a + dst*(255-a))。アルファも同式で
+ * out_a = a + dst_a*(1-a) になる。
+ */
+static void span_blend(uint8_t* dst, int n, const uint8_t src[4], unsigned a) {
+    int i = 0;
+    unsigned ia = 255u - a;
+#if defined(UI_RASTER_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i va   = _mm_set1_epi16((short)a);
+    const __m128i via  = _mm_set1_epi16((short)ia);
+    const __m128i r128 = _mm_set1_epi16(128);
+    uint32_t spx; memcpy(&spx, src, 4);
+    /* src*a は全ピクセル共通なので先に計算しておく */
+    __m128i s16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)spx), zero);
+    __m128i sa  = _mm_add_epi16(_mm_mullo_epi16(s16, va), r128);
+    for (; i + 4 <= n; i += 4) {
+        __m128i d  = _mm_loadu_si128((const __m128i*)(dst + i*4));
+        __m128i lo = _mm_unpacklo_epi8(d, zero);
+        __m128i hi = _mm_unpackhi_epi8(d, zero);
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, via), sa);
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, via), sa);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)(dst + i*4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(UI_RASTER_NEON)
+    uint32_t spx; memcpy(&spx, src, 4);
+    const uint8x8_t  via = vdup_n_u8((uint8_t)ia);
+    uint16x8_t sa = vmull_u8(vreinterpret_u8_u32(vdup_n_u32(spx)),
+                             vdup_n_u8((uint8_t)a));
+    sa = vaddq_u16(sa, vdupq_n_u16(128));
+    for (; i + 4 <= n; i += 4) {
+        uint8x16_t d  = vld1q_u8(dst + i*4);
+        uint16x8_t lo = vmlal_u8(sa, vget_low_u8(d),  via);
+        uint16x8_t hi = vmlal_u8(sa, vget_high_u8(d), via);
+        lo = vshrq_n_u16(vaddq_u16(lo, vshrq_n_u16(lo, 8)), 8);
+        hi = vshrq_n_u16(vaddq_u16(hi, vshrq_n_u16(hi, 8)), 8);
+        vst1q_u8(dst + i*4, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+#endif
+    for (; i < n; ++i) {
+        uint8_t* p = dst + i*4;
+        for (int c = 0; c < 4; ++c)
+            p[c] = div255(src[c] * a + p[c] * ia);
+    }
+}
+
+/* ── バッファ管理 ───────────────────────────────────────*/
+UIRaster* ui_raster_create(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+    UIRaster* r = (UIRaster*)calloc(1, sizeof(UIRaster));
+    if (!r) return NULL;
+    r->pixels = (uint8_t*)calloc((size_t)width * (size_t)height, 4);
+    if (!r->pixels) { free(r); return NULL; }
+    r->width  = width;
+    r->height = height;
+    r->clip[0] = (IRect){ 0, 0, width, height };
+    return r;
+}
+
+void ui_raster_destroy(UIRaster* r) {
+    if (!r) return;
+    free(r->pixels);
+    free(r);
+}
+
+int            ui_raster_width(const UIRaster* r)  { return r ? r->width  : 0; }
+int            ui_raster_height(const UIRaster* r) { return r ? r->height : 0; }
+const uint8_t* ui_raster_pixels(const UIRaster* r) { return r ? r->pixels : NULL; }
+
+/* ── 基本描画 ───────────────────────────────────────────*/
+void ui_raster_clear(UIRaster* r, float cr, float cg, float cb, float ca) {
+    if (!r) return;
+    uint8_t c[4] = { to_u8(cr), to_u8(cg), to_u8(cb), to_u8(ca) };
+    uint32_t px; memcpy(&px, c, 4);
+    span_fill(r->pixels, r->width * r->height, px);
+    r->stats.pixels_filled += (uint64_t)r->width * (uint64_t)r->height;
+    r->stats.spans  += (uint64_t)r->height;
+}
+
+void ui_raster_fill_rect(UIRaster* r, float x, float y, float w, float h,
+                         float cr, float cg, float cb, float ca) {
+    if (!r) return;
+    IRect o = clip_rect(r, x, y, w, h);
+    if (o.x0 >= o.x1 || o.y0 >= o.y1) return;
+    uint8_t  a = to_u8(ca);
+    if (a == 0) return;
+
+    int    n      = o.x1 - o.x0;
+    size_t stride = (size_t)r->width * 4;
+    uint8_t* row  = r->pixels + (size_t)o.y0 * stride + (size_t)o.x0 * 4;
+    if (a == 255) {
+        uint8_t c[4] = { to_u8(cr), to_u8(cg), to_u8(cb), 255 };
+        uint32_t px; memcpy(&px, c, 4);
+        for (int yy = o.y0; yy < o.y1; ++yy, row += stride)
+            span_fill(row, n, px);
+        r->stats.pixels_filled += (uint64_t)n * (uint64_t)(o.y1 - o.y0);
+    } else {
+        uint8_t c[4] = { to_u8(cr), to_u8(cg), to_u8(cb), 255 };
+        for (int yy = o.y0; yy < o.y1; ++yy, row += stride)
+            span_blend(row, n, c, a);
+        r->stats.pixels_blended += (uint64_t)n * (uint64_t)(o.y1 - o.y0);
+    }
+    r->stats.spans   += (uint64_t)(o.y1 - o.y0);
+    r->stats.rects++;
+}
+
+void ui_raster_rect_outline(UIRaster* r, float x, float y, float w, float h,
+                            float t, float cr, float cg, float cb, float ca) {
+    if (t <= 0.0f) return;
+    if (t * 2.0f >= w || t * 2.0f >= h) {
+        ui_raster_fill_rect(r, x, y, w, h, cr, cg, cb, ca);
+        return;
+    }
+    ui_raster_fill_rect(r, x,         y,         w, t,            cr, cg, cb, ca);
+    ui_raster_fill_rect(r, x,         y + h - t, w, t,            cr, cg, cb, ca);
+    ui_raster_fill_rect(r, x,         y + t,     t, h - t * 2.0f, cr, cg, cb, ca);
+    ui_raster_fill_rect(r, x + w - t, y + t,     t, h - t * 2.0f, cr, cg, cb, ca);
+}
+
+void ui_raster_push_clip(UIRaster* r, float x, float y, float w, float h) {
+    if (!r) return;
+    IRect o = clip_rect(r, x, y, w, h);
+    if (o.x1 < o.x0) o.x1 = o.x0;
+    if (o.y1 < o.y0) o.y1 = o.y0;
+    if (r->clip_top + 1 >= UI_RASTER_CLIP_DEPTH) {
+        r->clip_overflow++;         /* 溢れた push は無視し、対応する pop も無視する */
+        return;
+    }
+    r->clip[++r->clip_top] = o;
+}
+
+void ui_raster_pop_clip(UIRaster* r) {
+    if (!r) return;
+    if (r->clip_overflow > 0) { r->clip_overflow--; return; }
+    if (r->clip_top > 0) r->clip_top--;
+}
+
+/* ── ウィジェット ────────────────────────────────────────*/
+#define FILL(r, x, y, w, h, c) \
+    ui_raster_fill_rect((r), (x), (y), (w), (h), (c)[0], (c)[1], (c)[2], (c)[3])
+
+void ui_raster_button(UIRaster* r, float x, float y, float w, float h,
+                      int state) {
+    float c[4];
+    ui_button_color(state, &c[0], &c[1], &c[2], &c[3]);
+    FILL(r, x, y, w, h, c);
+    ui_raster_rect_outline(r, x, y, w, h, 1.0f,
+                           TH_BORDER[0], TH_BORDER[1], TH_BORDER[2], TH_BORDER[3]);
+}
+
+void ui_raster_slider(UIRaster* r, float x, float y, float w, float h,
+                      float norm_val) {
+    if (norm_val < 0.0f) norm_val = 0.0f;
+    if (norm_val > 1.0f) norm_val = 1.0f;
+    float track_h = h * 0.25f;
+    float track_y = y + (h - track_h) * 0.5f;
+    FILL(r, x, track_y, w, track_h, TH_TRACK);
+    FILL(r, x, track_y, w * norm_val, track_h, TH_FILL);
+    float knob_w = h * (2.0f / 3.0f);
+    FILL(r, x + w * norm_val - knob_w * 0.5f, y, knob_w, h, TH_KNOB);
+}
+
+void ui_raster_scroll(UIRaster* r, float x, float y, float w, float view_h,
+                      float content_h, float scroll) {
+    float bar_x = x + w - 12;
+    FILL(r, bar_x, y, 12, view_h, TH_TRACK);
+    if (content_h <= view_h) return;
+    /* ui_scroll と同じ計算でつまみ位置を決める */
+    float bar_h = view_h * (view_h / content_h);
+    float bar_y = y + scroll / (content_h - view_h) * (view_h - bar_h);
+    bool  over  = ui_hover(bar_x, bar_y, 12, bar_h);
+    FILL(r, bar_x + 2, bar_y, 8, bar_h, over ? TH_KNOB : TH_FILL);
+}
+
+void ui_raster_progress(UIRaster* r, float x, float y, float w, float h,
+                        float value) {
+    if (value < 0.0f) value = 0.0f;
+    if (value > 1.0f) value = 1.0f;
+    FILL(r, x, y, w, h, TH_BAR_BG);
+    FILL(r, x, y, w * value, h, TH_FILL);
+}
+
+void ui_raster_dropdown(UIRaster* r, float x, float y, float w, float h,
+                        int count, int selected, bool open) {
+    int hs = ui_hover(x, y, w, h) ? 1 : 0;
+    ui_raster_button(r, x, y, w, h, open ? 2 : hs);
+    /* 開閉マーク (右端の小矩形) */
+    FILL(r, x + w - h * 0.75f, y + h * 0.375f, h * 0.5f, h * 0.25f, TH_BORDER);
+    if (!open) return;
+    for (int i = 0; i < count; i++) {
+        float iy = y + h + h * i;
+        FILL(r, x, iy, w, h, (i == selected) ? TH_FILL : TH_PANEL);
+        if (ui_hover(x, iy, w, h))
+            FILL(r, x, iy, w, h, TH_HILITE);
+    }
+    ui_raster_rect_outline(r, x, y + h, w, h * count, 1.0f,
+                           TH_BORDER[0], TH_BORDER[1], TH_BORDER[2], TH_BORDER[3]);
+}
+
+void ui_raster_tab(UIRaster* r, float x, float y, float w, float h,
+                   bool selected) {
+    FILL(r, x, y, w, h, selected ? TH_FILL : TH_PANEL);
+    if (!selected && ui_hover(x, y, w, h))
+        FILL(r, x, y, w, h, TH_HILITE);
+    if (selected)
+        FILL(r, x, y + h - 3, w, 3, TH_KNOB);
+}
+
+/* ── PPM ────────────────────────────────────────────────*/
+bool ui_raster_write_ppm(const UIRaster* r, const char* path) {
+    if (!r || !path) return false;
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return false;
+    fprintf(fp, "P6\n%d %d\n255\n", r->width, r->height);
+    uint8_t* line = (uint8_t*)malloc((size_t)r->width * 3);
+    bool ok = line != NULL;
+    for (int y = 0; ok && y < r->height; ++y) {
+        const uint8_t* s = r->pixels + (size_t)y * r->width * 4;
+        for (int x = 0; x < r->width; ++x) {
+            line[x*3+0] = s[x*4+0];
+            line[x*3+1] = s[x*4+1];
+            line[x*3+2] = s[x*4+2];
+        }
+        ok = fwrite(line, 3, (size_t)r->width, fp) == (size_t)r->width;
+    }
+    free(line);
+    if (fclose(fp) != 0) ok = false;
+    return ok;
+}
+
+/* 空白とコメント (#...) を読み飛ばして 10 進整数を読む */
+static int ppm_read_int(FILE* fp) {
+    int c;
+    for (;;) {
+        c = fgetc(fp);
+        if (c == '#') { while (c != '\n' && c != EOF) c = fgetc(fp); continue; }
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+        break;
+    }
+    int v = 0, digits = 0;
+    while (c >= '0' && c <= '9' && v < 1000000) {
+        v = v * 10 + (c - '0');
+        digits++;
+        c = fgetc(fp);
+    }
+    return digits ? v : -1;   /* 末尾の区切り 1 文字は消費済み */
+}
+
+UIRaster* ui_raster_read_ppm(const char* path) {
+    if (!path) return NULL;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return NULL;
+    UIRaster* r = NULL;
+    if (fgetc(fp) == 'P' && fgetc(fp) == '6') {
+        int w = ppm_read_int(fp), h = ppm_read_int(fp), maxv = ppm_read_int(fp);
+        if (w > 0 && h > 0 && maxv == 255)
+            r = ui_raster_create(w, h);
+    }
+    if (r) {
+        uint8_t* line = (uint8_t*)malloc((size_t)r->width * 3);
+        bool ok = line != NULL;
+        for (int y = 0; ok && y < r->height; ++y) {
+            ok = fread(line, 3, (size_t)r->width, fp) == (size_t)r->width;
+            uint8_t* d = r->pixels + (size_t)y * r->width * 4;
+            for (int x = 0; ok && x < r->width; ++x) {
+                d[x*4+0] = line[x*3+0];
+                d[x*4+1] = line[x*3+1];
+                d[x*4+2] = line[x*3+2];
+                d[x*4+3] = 255;
+            }
+        }
+        free(line);
+        if (!ok) { ui_raster_destroy(r); r = NULL; }
+    }
+    fclose(fp);
+    return r;
+}
+
+/* ── PNG (stored deflate) ───────────────────────────────*/
+static uint32_t crc_table[256];
+static bool     crc_ready;
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t* p, size_t n) {
+    if (!crc_ready) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crc_table[i] = c;
+        }
+        crc_ready = true;
+    }
+    for (size_t i = 0; i < n; ++i)
+        crc = crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);  p[3] = (uint8_t)v;
+}
+
+static bool png_chunk(FILE* fp, const char* type, const uint8_t* data, size_t n) {
+    uint8_t hdr[8];
+    put_be32(hdr, (uint32_t)n);
+    memcpy(hdr + 4, type, 4);
+    uint32_t crc = crc32_update(0xFFFFFFFFu, hdr + 4, 4);
+    crc = crc32_update(crc, data, n) ^ 0xFFFFFFFFu;
+    uint8_t tail[4];
+    put_be32(tail, crc);
+    return fwrite(hdr, 1, 8, fp) == 8
+        && (n == 0 || fwrite(data, 1, n, fp) == n)
+        && fwrite(tail, 1, 4, fp) == 4;
+}
+
+bool ui_raster_write_png(const UIRaster* r, const char* path) {
+    if (!r || !path) return false;
+    size_t row_bytes = (size_t)r->width * 4 + 1;          /* フィルタ 0 + RGBA */
+    size_t raw       = row_bytes * (size_t)r->height;
+    size_t blocks    = (raw + 65534) / 65535;
+    size_t zlen      = 2 + raw + blocks * 5 + 4;
+    uint8_t* z = (uint8_t*)malloc(zlen);
+    if (!z) return false;
+
+    /* zlib ヘッダ + stored ブロック列 + adler32 */
+    size_t o = 0;
+    z[o++] = 0x78; z[o++] = 0x01;
+    uint32_t s1 = 1, s2 = 0;
+    size_t   pos = 0;              /* raw 内の論理位置 */
+    while (pos < raw) {
+        size_t n = raw - pos;
+        if (n > 65535) n = 65535;
+        z[o++] = (pos + n == raw) ? 1 : 0;
+        z[o++] = (uint8_t)n;         z[o++] = (uint8_t)(n >> 8);
+        z[o++] = (uint8_t)~n;        z[o++] = (uint8_t)(~n >> 8);
+        for (size_t i = 0; i < n; ++i, ++pos) {
+            size_t  y = pos / row_bytes, x = pos % row_bytes;
+            uint8_t b = x == 0 ? 0 : r->pixels[y * (size_t)r->width * 4 + x - 1];
+            z[o++] = b;
+            s1 = (s1 + b) % 65521u;
+            s2 = (s2 + s1) % 65521u;
+        }
+    }
+    put_be32(z + o, (s2 << 16) | s1);
+    o += 4;
+
+    FILE* fp = fopen(path, "wb");
+    if (!fp) { free(z); return false; }
+    static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8_t ihdr[13];
+    put_be32(ihdr,     (uint32_t)r->width);
+    put_be32(ihdr + 4, (uint32_t)r->height);
+    ihdr[8] = 8;  /* bit depth */
+    ihdr[9] = 6;  /* RGBA */
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+    bool ok = fwrite(sig, 1, 8, fp) == 8
+           && png_chunk(fp, "IHDR", ihdr, sizeof(ihdr))
+           && png_chunk(fp, "IDAT", z, o)
+           && png_chunk(fp, "IEND", NULL, 0);
+    free(z);
+    if (fclose(fp) != 0) ok = false;
+    return ok;
+}
+
+/* ── 比較・統計 ─────────────────────────────────────────*/
+long ui_raster_compare(const UIRaster* a, const UIRaster* b,
+                       int tolerance, bool compare_alpha) {
+    if (!a || !b || a->width != b->width || a->height != b->height) return -1;
+    size_t n = (size_t)a->width * (size_t)a->height;
+    int    chans = compare_alpha ? 4 : 3;
+    long   diff = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t* p = a->pixels + i*4;
+        const uint8_t* q = b->pixels + i*4;
+        for (int c = 0; c < chans; ++c) {
+            int d = (int)p[c] - (int)q[c];
+            if (d < 0) d = -d;
+            if (d > tolerance) { diff++; break; }
+        }
+    }
+    return diff;
+}
+
+void ui_raster_stats(const UIRaster* r, UIRasterStats* out) {
+    if (!out) return;
+    if (!r) { memset(out, 0, sizeof(*out)); return; }
+    *out = r->stats;
+}
+
+void ui_raster_reset_stats(UIRaster* r) {
+    if (r) memset(&r->stats, 0, sizeof(r->stats));
+}
+
+/* 時刻は描画呼び出しごとではなくフレーム単位で 2 回だけ取る
+ * (小さな矩形が多いとクロック取得のコストが計測を支配するため) */
+void ui_raster_begin_frame(UIRaster* r) {
+    if (r) r->frame_t0 = now_sec();
+}
+
+void ui_raster_end_frame(UIRaster* r) {
+    if (!r || r->frame_t0 == 0.0) return;
+    r->stats.seconds += now_sec() - r->frame_t0;
+    r->stats.frames++;
+    r->frame_t0 = 0.0;
+}
@@ -0,0 +1,661 @@
+/**
+ * src/ui_table.c — テーブル (列ソートの並べ替え順キャッシュ)
+ *
+ * データは列ごとの型付き配列のまま保持し、ソート結果は行番号の並べ替え順
+ * perm[] として持つ。表示は perm の一部を参照するだけなので 1M 行でも
+ * 毎フレームのコストは表示行数に比例する。
+ * - 数値列: キーを順序保存の uint64 に変換して LSD 基数ソート (11bit×6 パス,
+ *   全要素で同じ桁のパスは省略)。大きな表はスレッドで区間ごとにソートし k-way マージ
+ * - 文字列列: 安定マージソート
+ * - セル更新: 変更行を perm から抜いてソートし、二分探索で残りの順序へ挿入
+ *   (比較は O(k log n)、残りは逐次走査と memmove のみ)
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+#include "eng_ui.h"
+#include "eng_ui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define UI_MAX_TABLES          8
+#define UI_TABLE_RADIX_BITS    11
+#define UI_TABLE_RADIX_PASSES  6      /* 11 * 6 >= 64 */
+#define UI_TABLE_RADIX_SIZE    (1 << UI_TABLE_RADIX_BITS)
+#define UI_TABLE_PARALLEL_MIN  (1 << 18) /* これ以上の行数でスレッド分割 */
+#define UI_TABLE_MAX_THREADS   8
+
+typedef struct {
+    int      type;       /* UI_TABLE_* */
+    double*  f;
+    int64_t* i;
+    char**   s;
+    float    width;      /* 0 = 等分 */
+} UITableCol;
+
+typedef struct {
+    int         id;
+    bool        used;
+    int         cols, rows;
+    UITableCol* col;
+    /* ソート */
+    uint32_t*   perm;        /* 順位 → データ行 */
+    int         sort_col;    /* -1 = 元の順 */
+    bool        desc;
+    bool        sorted;      /* perm が sort_col/desc に一致しているか */
+    uint32_t*   dirty;       /* ソート列が変更された行 */
+    int         dirty_count;
+    uint8_t*    dirty_flag;
+    /* 表示 */
+    float       x, y, w, h, header_h, row_h;
+    int         scroll_row;
+    int         selected;
+    char        fmt[64];     /* ui_table_get_str の数値書式化用 */
+} UITable;
+
+static UITable tables[UI_MAX_TABLES];
+
+/* ── キー ───────────────────────────────────────────────*/
+
+/* 数値を「符号無し比較で同じ順序になる」64bit キーへ */
+static uint64_t key_f64(double v) {
+    uint64_t b;
+    memcpy(&b, &v, 8);
+    return (b & 0x8000000000000000ull) ? ~b : b ^ 0x8000000000000000ull;
+}
+
+static uint64_t row_key(const UITable* t, uint32_t row) {
+    const UITableCol* c = &t->col[t->sort_col];
+    uint64_t k = (c->type == UI_TABLE_F64)
+               ? key_f64(c->f[row])
+               : (uint64_t)c->i[row] ^ 0x8000000000000000ull;
+    return t->desc ? ~k : k;
+}
+
+/* (キー, 行番号) の順で a < b か */
+static bool row_less(const UITable* t, uint32_t a, uint32_t b) {
+    const UITableCol* c = &t->col[t->sort_col];
+    if (c->type == UI_TABLE_STR) {
+        int r = strcmp(c->s[a] ? c->s[a] : "", c->s[b] ? c->s[b] : "");
+        if (t->desc) r = -r;
+        if (r != 0) return r < 0;
+    } else {
+        uint64_t ka = row_key(t, a), kb = row_key(t, b);
+        if (ka != kb) return ka < kb;
+    }
+    return a < b;
+}
+
+/* ── 基数ソート ─────────────────────────────────────────*/
+typedef struct {
+    uint64_t* k;  uint32_t* v;     /* 入力 / 結果 */
+    uint64_t* tk; uint32_t* tv;    /* 作業領域 */
+    size_t    n;
+    uint32_t  hist[UI_TABLE_RADIX_PASSES][UI_TABLE_RADIX_SIZE];
+} RadixJob;
+
+/* (k, v) を k について安定ソートする。結果は k/v に戻る。 */
+static void radix_run(RadixJob* j) {
+    size_t n = j->n;
+    if (n < 2) return;
+    memset(j->hist, 0, sizeof(j->hist));
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t k = j->k[i];
+        for (int p = 0; p < UI_TABLE_RADIX_PASSES; ++p)
+            j->hist[p][(k >> (p * UI_TABLE_RADIX_BITS)) & (UI_TABLE_RADIX_SIZE - 1)]++;
+    }
+    uint64_t* sk = j->k;  uint32_t* sv = j->v;
+    uint64_t* dk = j->tk; uint32_t* dv = j->tv;
+    for (int p = 0; p < UI_TABLE_RADIX_PASSES; ++p) {
+        int shift = p * UI_TABLE_RADIX_BITS;
+        uint32_t* h = j->hist[p];
+        if (h[(sk[0] >> shift) & (UI_TABLE_RADIX_SIZE - 1)] == n) continue;  /* 全要素同じ桁 */
+        uint32_t sum = 0;
+        for (int b = 0; b < UI_TABLE_RADIX_SIZE; ++b) {
+            uint32_t c = h[b]; h[b] = sum; sum += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t d = h[(sk[i] >> shift) & (UI_TABLE_RADIX_SIZE - 1)]++;
+            dk[d] = sk[i];
+            dv[d] = sv[i];
+        }
+        uint64_t* xk = sk; sk = dk; dk = xk;
+        uint32_t* xv = sv; sv = dv; dv = xv;
+    }
+    if (sk != j->k) {
+        memcpy(j->k, sk, n * sizeof(uint64_t));
+        memcpy(j->v, sv, n * sizeof(uint32_t));
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI radix_thread(LPVOID p) { radix_run((RadixJob*)p); return 0; }
+#else
+static void* radix_thread(void* p) { radix_run((RadixJob*)p); return NULL; }
+#endif
+
+static int cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+/*
+ * n 要素を基数ソート。大きければ区間ごとに別スレッドでソートし、
+ * 区間の先頭同士を比べる k-way マージでまとめる (同値は前の区間 = 小さい行番号が先)。
+ */
+static bool radix_sort(uint64_t* k, uint32_t* v, size_t n) {
+    int threads = 1;
+    if (n >= UI_TABLE_PARALLEL_MIN) {
+        threads = cpu_count();
+        if (threads > UI_TABLE_MAX_THREADS) threads = UI_TABLE_MAX_THREADS;
+        if (threads < 1) threads = 1;
+    }
+    uint64_t* tk   = (uint64_t*)malloc(n * sizeof(uint64_t));
+    uint32_t* tv   = (uint32_t*)malloc(n * sizeof(uint32_t));
+    RadixJob* jobs = (RadixJob*)malloc(sizeof(RadixJob) * (size_t)threads);
+    if (!tk || !tv || !jobs) { free(tk); free(tv); free(jobs); return false; }
+
+    size_t chunk = (n + (size_t)threads - 1) / (size_t)threads;
+    for (int t = 0; t < threads; ++t) {
+        size_t lo = chunk * (size_t)t;
+        size_t hi = lo + chunk < n ? lo + chunk : n;
+        if (lo > n) lo = n;
+        jobs[t].k  = k + lo;  jobs[t].v  = v + lo;
+        jobs[t].tk = tk + lo; jobs[t].tv = tv + lo;
+        jobs[t].n  = hi - lo;
+    }
+
+    if (threads == 1) {
+        radix_run(&jobs[0]);
+    } else {
+#ifdef _WIN32
+        HANDLE th[UI_TABLE_MAX_THREADS];
+        for (int t = 1; t < threads; ++t) {
+            th[t] = CreateThread(NULL, 0, radix_thread, &jobs[t], 0, NULL);
+            if (!th[t]) radix_run(&jobs[t]);
+        }
+        radix_run(&jobs[0]);
+        for (int t = 1; t < threads; ++t)
+            if (th[t]) { WaitForSingleObject(th[t], INFINITE); CloseHandle(th[t]); }
+#else
+        pthread_t th[UI_TABLE_MAX_THREADS];
+        bool      ok[UI_TABLE_MAX_THREADS];
+        for (int t = 1; t < threads; ++t) {
+            ok[t] = pthread_create(&th[t], NULL, radix_thread, &jobs[t]) == 0;
+            if (!ok[t]) radix_run(&jobs[t]);
+        }
+        radix_run(&jobs[0]);
+        for (int t = 1; t < threads; ++t)
+            if (ok[t]) pthread_join(th[t], NULL);
+#endif
+        /* k-way マージ (区間数は高々 8 なので線形に最小を選ぶ) */
+        size_t pos[UI_TABLE_MAX_THREADS];
+        for (int t = 0; t < threads; ++t) pos[t] = 0;
+        for (size_t o = 0; o < n; ++o) {
+            int best = -1;
+            for (int t = 0; t < threads; ++t) {
+                if (pos[t] >= jobs[t].n) continue;
+                if (best < 0 || jobs[t].k[pos[t]] < jobs[best].k[pos[best]]) best = t;
+            }
+            tk[o] = jobs[best].k[pos[best]];
+            tv[o] = jobs[best].v[pos[best]];
+            pos[best]++;
+        }
+        memcpy(v, tv, n * sizeof(uint32_t));
+    }
+    free(tk); free(tv); free(jobs);
+    return true;
+}
+
+/* 行番号列 v[0..n) を row_less で安定マージソート (文字列列・小さい差分用) */
+static void merge_sort_rows(const UITable* t, uint32_t* v, size_t n) {
+    if (n < 2) return;
+    uint32_t* tmp = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (!tmp) {                              /* 確保失敗時は挿入ソート */
+        for (size_t i = 1; i < n; ++i) {
+            uint32_t x = v[i]; size_t j = i;
+            while (j > 0 && row_less(t, x, v[j-1])) { v[j] = v[j-1]; j--; }
+            v[j] = x;
+        }
+        return;
+    }
+    uint32_t* src = v; uint32_t* dst = tmp;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += width * 2) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi  = lo + width * 2 < n ? lo + width * 2 : n;
+            size_t a = lo, b = mid, o = lo;
+            while (a < mid && b < hi) dst[o++] = row_less(t, src[b], src[a]) ? src[b++] : src[a++];
+            while (a < mid) dst[o++] = src[a++];
+            while (b < hi)  dst[o++] = src[b++];
+        }
+        uint32_t* x = src; src = dst; dst = x;
+    }
+    if (src != v) memcpy(v, src, n * sizeof(uint32_t));
+    free(tmp);
+}
+
+/* 行番号列 v[0..n) を現在のソート列でソート */
+static void sort_rows(const UITable* t, uint32_t* v, size_t n) {
+    if (t->col[t->sort_col].type == UI_TABLE_STR) { merge_sort_rows(t, v, n); return; }
+    uint64_t* keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    bool ok = keys != NULL;
+    if (ok) {
+        for (size_t i = 0; i < n; ++i) keys[i] = row_key(t, v[i]);
+        ok = radix_sort(keys, v, n);
+    }
+    free(keys);
+    if (!ok) merge_sort_rows(t, v, n);
+}
+
+static void clear_dirty(UITable* t) {
+    for (int i = 0; i < t->dirty_count; ++i) t->dirty_flag[t->dirty[i]] = 0;
+    t->dirty_count = 0;
+}
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* perm をソート状態に合わせる (必要な分だけ) */
+static void ensure_sorted(UITable* t) {
+    if (t->sorted && t->dirty_count == 0) return;
+    size_t n = (size_t)t->rows;
+    const UITableCol* sc = (t->sort_col >= 0 && t->sort_col < t->cols)
+                         ? &t->col[t->sort_col] : NULL;
+    if (!sc || !(sc->f || sc->i || sc->s)) {
+        for (size_t i = 0; i < n; ++i) t->perm[i] = (uint32_t)i;
+    } else if (!t->sorted) {
+        ui_profile_begin("ui.table_sort");
+        for (size_t i = 0; i < n; ++i) t->perm[i] = (uint32_t)i;
+        sort_rows(t, t->perm, n);
+        ui_profile_end();
+    } else {
+        /* 差分: 変更行を抜き、ソートして既存順へ後ろからマージ */
+        ui_profile_begin("ui.table_resort");
+        size_t k = (size_t)t->dirty_count, m = 0;
+        for (size_t i = 0; i < n; ++i)
+            if (!t->dirty_flag[t->perm[i]]) t->perm[m++] = t->perm[i];
+        qsort(t->dirty, k, sizeof(uint32_t), cmp_u32);   /* 同値時の行番号順のため */
+        sort_rows(t, t->dirty, k);
+        /* 大きい方から二分探索で挿入位置を求め、間の区間は memmove でずらす */
+        size_t a = m, o = n;
+        for (size_t b = k; b > 0; --b) {
+            uint32_t r = t->dirty[b-1];
+            size_t lo = 0, hi = a;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (row_less(t, r, t->perm[mid])) hi = mid;
+                else                              lo = mid + 1;
+            }
+            o -= a - lo;
+            memmove(t->perm + o, t->perm + lo, (a - lo) * sizeof(uint32_t));
+            t->perm[--o] = r;
+            a = lo;
+        }
+        ui_profile_end();
+    }
+    clear_dirty(t);
+    t->sorted = true;
+}
+
+/* ソート列のセルが変わった */
+static void mark_dirty(UITable* t, int col, int row) {
+    if (col != t->sort_col || !t->sorted) return;
+    if (t->dirty_flag[row]) return;
+    /* 変更が多ければ全体をソートし直す方が速い */
+    if (t->dirty_count >= t->rows / 16 + 1) {
+        clear_dirty(t);
+        t->sorted = false;
+        return;
+    }
+    t->dirty_flag[row] = 1;
+    t->dirty[t->dirty_count++] = (uint32_t)row;
+}
+
+/* ── 管理 ───────────────────────────────────────────────*/
+static void col_free(UITableCol* c, int rows) {
+    if (c->s) for (int r = 0; r < rows; ++r) free(c->s[r]);
+    free(c->f); free(c->i); free(c->s);
+    c->f = NULL; c->i = NULL; c->s = NULL;
+}
+
+static void table_free(UITable* t) {
+    for (int c = 0; c < t->cols; ++c) col_free(&t->col[c], t->rows);
+    free(t->col);
+    free(t->perm);
+    free(t->dirty);
+    free(t->dirty_flag);
+}
+
+static UITable* table_get(int id) {
+    UITable* found = NULL;
+    ui_profile_begin("ui.table_get");
+    for (int i = 0; i < UI_MAX_TABLES && !found; ++i)
+        if (tables[i].used && tables[i].id == id) found = &tables[i];
+    for (int i = 0; i < UI_MAX_TABLES && !found; ++i) {
+        if (!tables[i].used) {
+            memset(&tables[i], 0, sizeof(UITable));
+            tables[i].id       = id;
+            tables[i].used     = true;
+            tables[i].sort_col = -1;
+            tables[i].selected = -1;
+            found = &tables[i];
+        }
+    }
+    ui_profile_end();
+    return found;
+}
+
+void ui_table_reset_all(void) {
+    for (int i = 0; i < UI_MAX_TABLES; ++i) {
+        if (tables[i].used) table_free(&tables[i]);
+        memset(&tables[i], 0, sizeof(UITable));
+    }
+}
+
+bool ui_table_setup(int id, int columns, int rows) {
+    UITable* t = table_get(id);
+    if (!t || columns < 0 || rows < 0) return false;
+    table_free(t);
+    t->cols = t->rows = 0;
+    t->col  = (UITableCol*)calloc((size_t)(columns ? columns : 1), sizeof(UITableCol));
+    t->perm = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(rows ? rows : 1));
+    t->dirty      = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(rows / 16 + 1));
+    t->dirty_flag = (uint8_t*)calloc((size_t)(rows ? rows : 1), 1);
+    if (!t->col || !t->perm || !t->dirty || !t->dirty_flag) {
+        free(t->col); free(t->perm); free(t->dirty); free(t->dirty_flag);
+        t->col = NULL; t->perm = NULL; t->dirty = NULL; t->dirty_flag = NULL;
+        return false;
+    }
+    t->cols = columns;
+    t->rows = rows;
+    for (int c = 0; c < columns; ++c) t->col[c].type = UI_TABLE_F64;
+    for (int r = 0; r < rows; ++r) t->perm[r] = (uint32_t)r;
+    t->sort_col    = -1;
+    t->desc        = false;
+    t->sorted      = true;
+    t->dirty_count = 0;
+    t->scroll_row  = 0;
+    t->selected    = -1;
+    return true;
+}
+
+/* col を type 型の空列にする。失敗時 NULL */
+static UITableCol* col_reset(UITable* t, int col, int type) {
+    if (!t || col < 0 || col >= t->cols) return NULL;
+    UITableCol* c = &t->col[col];
+    col_free(c, t->rows);
+    size_t n = (size_t)(t->rows ? t->rows : 1);
+    c->type = type;
+    if (type == UI_TABLE_F64)      c->f = (double*)calloc(n, sizeof(double));
+    else if (type == UI_TABLE_I64) c->i = (int64_t*)calloc(n, sizeof(int64_t));
+    else                           c->s = (char**)calloc(n, sizeof(char*));
+    if (!c->f && !c->i && !c->s) { c->type = UI_TABLE_F64; return NULL; }
+    if (col == t->sort_col) { clear_dirty(t); t->sorted = false; }
+    return c;
+}
+
+/* セル更新の対象列。まだデータの無い列だけ type で作り、
+ * 既存の列の型は変えない (型を変えるのは set_column_* のみ)。 */
+static UITableCol* col_cell(UITable* t, int col, int type) {
+    if (!t || col < 0 || col >= t->cols) return NULL;
+    UITableCol* c = &t->col[col];
+    if (c->f || c->i || c->s) return c;
+    return col_reset(t, col, type);
+}
+
+static int clamp_rows(const UITable* t, int rows) {
+    if (rows < 0) return 0;
+    return rows < t->rows ? rows : t->rows;
+}
+
+void ui_table_set_column_f64(int id, int col, const double* data, int rows) {
+    UITable* t = table_get(id);
+    UITableCol* c = col_reset(t, col, UI_TABLE_F64);
+    if (c && data) memcpy(c->f, data, sizeof(double) * (size_t)clamp_rows(t, rows));
+}
+
+void ui_table_set_column_i64(int id, int col, const int64_t* data, int rows) {
+    UITable* t = table_get(id);
+    UITableCol* c = col_reset(t, col, UI_TABLE_I64);
+    if (c && data) memcpy(c->i, data, sizeof(int64_t) * (size_t)clamp_rows(t, rows));
+}
+
+void ui_table_set_column_str(int id, int col, const char* const* data, int rows) {
+    UITable* t = table_get(id);
+    UITableCol* c = col_reset(t, col, UI_TABLE_STR);
+    if (!c || !data) return;
+    rows = clamp_rows(t, rows);
+    for (int r = 0; r < rows; ++r) {
+        if (!data[r]) continue;
+        size_t len = strlen(data[r]);
+        c->s[r] = (char*)malloc(len + 1);
+        if (c->s[r]) memcpy(c->s[r], data[r], len + 1);
+    }
+}
+
+/* 列の型のままセルへ書く */
+static void cell_f64(UITable* t, UITableCol* c, int col, int row, double v) {
+    if (c->f[row] == v) return;
+    c->f[row] = v;
+    mark_dirty(t, col, row);
+}
+
+static void cell_i64(UITable* t, UITableCol* c, int col, int row, int64_t v) {
+    if (c->i[row] == v) return;
+    c->i[row] = v;
+    mark_dirty(t, col, row);
+}
+
+static void cell_str(UITable* t, UITableCol* c, int col, int row, const char* v) {
+    if (c->s[row] && strcmp(c->s[row], v) == 0) return;
+    size_t len = strlen(v);
+    char* s = (char*)malloc(len + 1);
+    if (!s) return;
+    memcpy(s, v, len + 1);
+    free(c->s[row]);
+    c->s[row] = s;
+    mark_dirty(t, col, row);
+}
+
+/* 実数 → 整数列。小数部は切り捨て、範囲外は飽和。NaN は書けない */
+static bool f64_to_i64(double v, int64_t* out) {
+    if (isnan(v)) return false;
+    if (v >= 9223372036854775807.0)       *out = INT64_MAX;
+    else if (v <= -9223372036854775808.0) *out = INT64_MIN;
+    else                                  *out = (int64_t)v;
+    return true;
+}
+
+void ui_table_set_cell_f64(int id, int col, int row, double v) {
+    UITable* t = table_get(id);
+    if (!t || row < 0 || row >= t->rows) return;
+    UITableCol* c = col_cell(t, col, UI_TABLE_F64);
+    if (!c) return;
+    if (c->type == UI_TABLE_F64) { cell_f64(t, c, col, row, v); return; }
+    if (c->type == UI_TABLE_I64) {
+        int64_t i;
+        if (f64_to_i64(v, &i)) cell_i64(t, c, col, row, i);
+        return;
+    }
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%g", v);   /* ui_table_get_str と同じ書式 */
+    cell_str(t, c, col, row, buf);
+}
+
+void ui_table_set_cell_i64(int id, int col, int row, int64_t v) {
+    UITable* t = table_get(id);
+    if (!t || row < 0 || row >= t->rows) return;
+    UITableCol* c = col_cell(t, col, UI_TABLE_I64);
+    if (!c) return;
+    if (c->type == UI_TABLE_I64) { cell_i64(t, c, col, row, v); return; }
+    if (c->type == UI_TABLE_F64) { cell_f64(t, c, col, row, (double)v); return; }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%lld", (long long)v);
+    cell_str(t, c, col, row, buf);
+}
+
+void ui_table_set_cell_str(int id, int col, int row, const char* v) {
+    UITable* t = table_get(id);
+    if (!t || row < 0 || row >= t->rows) return;
+    UITableCol* c = col_cell(t, col, UI_TABLE_STR);
+    if (!c) return;
+    if (!v) v = "";
+    if (c->type == UI_TABLE_STR) { cell_str(t, c, col, row, v); return; }
+    /* 数値列には全体が数値として読める文字列だけ書く。それ以外は無視 */
+    char* end;
+    if (c->type == UI_TABLE_I64) {
+        errno = 0;
+        long long i = strtoll(v, &end, 10);
+        if (end != v && *end == '\0' && errno == 0) { cell_i64(t, c, col, row, (int64_t)i); return; }
+        double d = strtod(v, &end);   /* "1.5" などは実数として読んで切り捨て */
+        int64_t di;
+        if (end != v && *end == '\0' && f64_to_i64(d, &di)) cell_i64(t, c, col, row, di);
+        return;
+    }
+    double d = strtod(v, &end);
+    if (end != v && *end == '\0') cell_f64(t, c, col, row, d);
+}
+
+void ui_table_set_column_width(int id, int col, float w) {
+    UITable* t = table_get(id);
+    if (t && col >= 0 && col < t->cols) t->col[col].width = w > 0.0f ? w : 0.0f;
+}
+
+/* ── ウィジェット ────────────────────────────────────────*/
+static float col_width(const UITable* t, int c) {
+    return t->col[c].width > 0.0f ? t->col[c].width : t->w / (float)t->cols;
+}
+
+static int body_rows(const UITable* t) {
+    if (t->row_h <= 0.0f) return 0;
+    float body = t->h - t->header_h;
+    return body > 0.0f ? (int)ceilf(body / t->row_h) : 0;
+}
+
+static void clamp_scroll(UITable* t) {
+    int full = t->row_h > 0.0f ? (int)floorf((t->h - t->header_h) / t->row_h) : 0;
+    int max_scroll = t->rows - (full > 0 ? full : 0);
+    if (t->scroll_row > max_scroll) t->scroll_row = max_scroll;
+    if (t->scroll_row < 0) t->scroll_row = 0;
+}
+
+int ui_table(int id, float x, float y, float w, float h,
+             float header_h, float row_h, float wheel_dy) {
+    UITable* t = table_get(id);
+    if (!t) return -1;
+    t->x = x; t->y = y; t->w = w; t->h = h;
+    t->header_h = header_h;
+    t->row_h    = row_h;
+
+    float mx, my;
+    ui_mouse_state(&mx, &my, NULL, NULL);
+
+    /* ヘッダー: 列を選んでソート (同じ列なら方向反転) */
+    if (t->cols > 0 && ui_click(x, y, w, header_h)) {
+        float cx = x;
+        for (int c = 0; c < t->cols; ++c) {
+            float cw = col_width(t, c);
+            if (mx >= cx && mx < cx + cw) {
+                if (c == t->sort_col) ui_table_sort(id, c, !t->desc);
+                else                  ui_table_sort(id, c, false);
+                break;
+            }
+            cx += cw;
+        }
+    }
+
+    if (wheel_dy != 0.0f && ui_hover(x, y + header_h, w, h - header_h))
+        t->scroll_row += (int)(wheel_dy * 3.0f);
+    clamp_scroll(t);
+
+    int clicked = -1;
+    if (row_h > 0.0f && ui_click(x, y + header_h, w, h - header_h)) {
+        int pos = t->scroll_row + (int)floorf((my - y - header_h) / row_h);
+        if (pos >= 0 && pos < t->rows) {
+            ensure_sorted(t);
+            clicked = t->selected = (int)t->perm[pos];
+        }
+    }
+    return clicked;
+}
+
+void ui_table_sort(int id, int col, bool descending) {
+    UITable* t = table_get(id);
+    if (!t) return;
+    if (col < 0 || col >= t->cols) col = -1;
+    if (col == t->sort_col && descending == t->desc) return;
+    t->sort_col = col;
+    t->desc     = descending;
+    clear_dirty(t);
+    t->sorted   = false;
+}
+
+int ui_table_sort_column(int id, bool* descending) {
+    UITable* t = table_get(id);
+    if (descending) *descending = t ? t->desc : false;
+    return t ? t->sort_col : -1;
+}
+
+int ui_table_visible(int id, int* first) {
+    UITable* t = table_get(id);
+    if (!t) { if (first) *first = 0; return 0; }
+    ensure_sorted(t);
+    clamp_scroll(t);
+    int n = body_rows(t);
+    if (t->scroll_row + n > t->rows) n = t->rows - t->scroll_row;
+    if (first) *first = t->scroll_row;
+    return n > 0 ? n : 0;
+}
+
+int ui_table_row_at(int id, int pos) {
+    UITable* t = table_get(id);
+    if (!t || pos < 0 || pos >= t->rows) return -1;
+    ensure_sorted(t);
+    return (int)t->perm[pos];
+}
+
+int ui_table_selected(int id) {
+    UITable* t = table_get(id);
+    return t ? t->selected : -1;
+}
+
+double ui_table_get_f64(int id, int col, int row) {
+    UITable* t = table_get(id);
+    if (!t || col < 0 || col >= t->cols || row < 0 || row >= t->rows) return 0.0;
+    const UITableCol* c = &t->col[col];
+    if (c->f) return c->f[row];
+    if (c->i) return (double)c->i[row];
+    return 0.0;
+}
+
+const char* ui_table_get_str(int id, int col, int row) {
+    UITable* t = table_get(id);
+    if (!t || col < 0 || col >= t->cols || row < 0 || row >= t->rows) return "";
+    const UITableCol* c = &t->col[col];
+    if (c->s) return c->s[row] ? c->s[row] : "";
+    if (c->i) snprintf(t->fmt, sizeof(t->fmt), "%lld", (long long)c->i[row]);
+    else if (c->f) snprintf(t->fmt, sizeof(t->fmt), "%g", c->f[row]);
+    else t->fmt[0] = '\0';
+    return t->fmt;
+}
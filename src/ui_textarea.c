@@ -0,0 +1,760 @@
+/**
+ * src/ui_textarea.c — 複数行テキストエリア (行ロープ + 折り返しキャッシュ)
+ *
+ * 文書は論理行を葉とする暗黙キー treap で保持する。各ノードは 1 行分の
+ * 文字列 (改行を含まない) と、部分木の行数 / バイト数 / 表示行数を持つ。
+ * - n 行目・オフセット→行・表示行→行 の検索は木を 1 回下るだけ (O(log n))
+ * - 行の挿入/削除は split/merge (O(log n))
+ * - 1 文字の編集は該当行の memmove と経路上の集計更新のみ
+ * - 各行の表示行数 (rows) が折り返しキャッシュ。編集した行だけ再計算する
+ * 行の中身は 1 本の文字列なので、行内の編集・折り返し・キャレット位置の計算は
+ * その行の長さに比例する (1 行が数百 KB の文書では 1 打鍵ごとに線形)。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#include "eng_ui.h"
+#include "eng_ui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define UI_MAX_TEXTAREAS 8
+
+typedef struct {
+    char*    text;      /* NUL 終端 */
+    int      len, cap;
+    int      rows;      /* 折り返し後の表示行数 (>= 1) */
+    int      l, r;
+    uint32_t prio;
+    int      cnt;       /* 部分木の論理行数 */
+    int      sum_rows;  /* 部分木の表示行数 */
+    long     bytes;     /* 部分木のバイト数 (各行 len + 改行 1) */
+} TANode;
+
+typedef struct {
+    int      id;
+    bool     used;
+    TANode*  nodes;        /* nodes[0] は番兵 (空) */
+    int      node_count, node_cap;
+    int*     free_ids;
+    int      free_count, free_cap;
+    int      root;
+    uint32_t rng;
+    /* キャレット (col はバイト位置) */
+    int      caret_line, caret_col;
+    int      sticky_x;     /* 上下移動で保つ桁 (コードポイント), -1 = 未設定 */
+    /* 表示 */
+    float    x, y, w, h;
+    float    char_w, line_h;
+    bool     wrap;
+    int      wrap_cols;    /* 0 = 折り返し無し */
+    int      scroll_row;
+    bool     focused;
+    char*    vis;          /* ui_textarea_visible_text の返却用 */
+    long     vis_cap;
+} UITextArea;
+
+static UITextArea areas[UI_MAX_TEXTAREAS];
+
+/* ── UTF-8 ──────────────────────────────────────────────*/
+static int u8_len(unsigned char c) {
+    if (c < 0x80) return 1;
+    if ((c & 0xE0) == 0xC0) return 2;
+    if ((c & 0xF0) == 0xE0) return 3;
+    if ((c & 0xF8) == 0xF0) return 4;
+    return 1;   /* 不正バイトは 1 バイト 1 文字扱い */
+}
+
+static int u8_next(const char* s, int len, int i) {
+    int n = i + u8_len((unsigned char)s[i]);
+    return n > len ? len : n;
+}
+
+static int u8_prev(const char* s, int i) {
+    if (i <= 0) return 0;
+    i--;
+    while (i > 0 && ((unsigned char)s[i] & 0xC0) == 0x80) i--;
+    return i;
+}
+
+static int u8_count(const char* s, int from, int to) {
+    int n = 0;
+    for (int i = from; i < to; i = u8_next(s, to, i)) n++;
+    return n;
+}
+
+/* ── 折り返し ───────────────────────────────────────────*/
+
+/* start から始まる表示行の終端を返す。空白で区切れればその直後で折る。 */
+static int wrap_next(const char* s, int len, int start, int cols) {
+    if (cols <= 0) return len;
+    int i = start, n = 0, last_space = -1;
+    while (i < len && n < cols) {
+        if (s[i] == ' ' || s[i] == '\t') last_space = i + 1;
+        i = u8_next(s, len, i);
+        n++;
+    }
+    if (i >= len) return len;
+    if (s[i] == ' ' || s[i] == '\t') return i + 1;   /* 行末の空白 1 つは同じ行に */
+    if (last_space > start) return last_space;
+    return i;
+}
+
+static int line_rows(const TANode* nd, int cols) {
+    if (cols <= 0 || nd->len == 0) return 1;
+    int rows = 0;
+    for (int s = 0; s < nd->len; s = wrap_next(nd->text, nd->len, s, cols)) rows++;
+    return rows;
+}
+
+/* byte col を含む表示行番号と、その行の [start, end) を求める */
+static int row_of_col(const TANode* nd, int cols, int col, int* rs, int* re) {
+    int row = 0, s = 0;
+    for (;;) {
+        int e = wrap_next(nd->text, nd->len, s, cols);
+        if (col < e || e >= nd->len) { *rs = s; *re = e; return row; }
+        s = e;
+        row++;
+    }
+}
+
+/* 表示行 row の [start, end) を求める (row は行内で有効な値) */
+static void row_span(const TANode* nd, int cols, int row, int* rs, int* re) {
+    int s = 0, e = wrap_next(nd->text, nd->len, 0, cols);
+    while (row-- > 0 && e < nd->len) { s = e; e = wrap_next(nd->text, nd->len, s, cols); }
+    *rs = s; *re = e;
+}
+
+/* 表示行 [rs, re) 内で xcol 桁目 (コードポイント) のバイト位置 */
+static int col_in_row(const TANode* nd, int rs, int re, int xcol) {
+    /* 行末でない表示行では最後の文字の手前までしか置けない (次の行頭と同じになるため) */
+    int limit = (re < nd->len) ? u8_prev(nd->text, re) : re;
+    if (limit < rs) limit = rs;
+    int i = rs;
+    while (xcol-- > 0 && i < limit) i = u8_next(nd->text, nd->len, i);
+    return i;
+}
+
+/* ── treap ──────────────────────────────────────────────*/
+#define N(ta, i) ((ta)->nodes[i])
+
+static void pull(UITextArea* ta, int t) {
+    TANode* n = &N(ta, t);
+    n->cnt      = 1 + N(ta, n->l).cnt + N(ta, n->r).cnt;
+    n->sum_rows = n->rows + N(ta, n->l).sum_rows + N(ta, n->r).sum_rows;
+    n->bytes    = n->len + 1 + N(ta, n->l).bytes + N(ta, n->r).bytes;
+}
+
+/* 先頭 k 行を *a に、残りを *b に */
+static void split(UITextArea* ta, int t, int k, int* a, int* b) {
+    if (!t) { *a = *b = 0; return; }
+    int lc = N(ta, N(ta, t).l).cnt;
+    if (k <= lc) {
+        split(ta, N(ta, t).l, k, a, &N(ta, t).l);
+        *b = t;
+    } else {
+        split(ta, N(ta, t).r, k - lc - 1, &N(ta, t).r, b);
+        *a = t;
+    }
+    pull(ta, t);
+}
+
+static int merge(UITextArea* ta, int a, int b) {
+    if (!a || !b) return a ? a : b;
+    if (N(ta, a).prio > N(ta, b).prio) {
+        N(ta, a).r = merge(ta, N(ta, a).r, b);
+        pull(ta, a);
+        return a;
+    }
+    N(ta, b).l = merge(ta, a, N(ta, b).l);
+    pull(ta, b);
+    return b;
+}
+
+/* k 行目のノード */
+static int nth(UITextArea* ta, int k) {
+    int t = ta->root;
+    while (t) {
+        int lc = N(ta, N(ta, t).l).cnt;
+        if (k < lc)       t = N(ta, t).l;
+        else if (k == lc) return t;
+        else            { k -= lc + 1; t = N(ta, t).r; }
+    }
+    return 0;
+}
+
+/* k 行目より前の表示行数 */
+static int rows_before(UITextArea* ta, int k) {
+    int t = ta->root, acc = 0;
+    while (t) {
+        int lc = N(ta, N(ta, t).l).cnt;
+        if (k <= lc) t = N(ta, t).l;
+        else {
+            acc += N(ta, N(ta, t).l).sum_rows + N(ta, t).rows;
+            k -= lc + 1;
+            t = N(ta, t).r;
+        }
+    }
+    return acc;
+}
+
+/* 表示行 row を含む論理行番号。*row_in_line に行内の表示行番号を書く */
+static int line_at_row(UITextArea* ta, int row, int* row_in_line) {
+    int t = ta->root, line = 0;
+    if (row < 0) row = 0;
+    if (row >= N(ta, t).sum_rows) {            /* 末尾を超えたら最終行の最終表示行 */
+        int last = N(ta, t).cnt - 1;
+        *row_in_line = N(ta, nth(ta, last)).rows - 1;
+        return last;
+    }
+    while (t) {
+        int lr = N(ta, N(ta, t).l).sum_rows;
+        if (row < lr) { t = N(ta, t).l; continue; }
+        line += N(ta, N(ta, t).l).cnt;
+        row  -= lr;
+        if (row < N(ta, t).rows) { *row_in_line = row; return line; }
+        row  -= N(ta, t).rows;
+        line += 1;
+        t = N(ta, t).r;
+    }
+    *row_in_line = 0;
+    return line;
+}
+
+/* k 行目を変更した後、根からの経路の集計を更新する */
+static void touch(UITextArea* ta, int t, int k) {
+    int lc = N(ta, N(ta, t).l).cnt;
+    if (k < lc)      touch(ta, N(ta, t).l, k);
+    else if (k > lc) touch(ta, N(ta, t).r, k - lc - 1);
+    pull(ta, t);
+}
+
+static void rewrap_all(UITextArea* ta, int t) {
+    if (!t) return;
+    rewrap_all(ta, N(ta, t).l);
+    rewrap_all(ta, N(ta, t).r);
+    N(ta, t).rows = line_rows(&N(ta, t), ta->wrap_cols);
+    pull(ta, t);
+}
+
+static void free_tree(UITextArea* ta, int t) {
+    if (!t) return;
+    free_tree(ta, N(ta, t).l);
+    free_tree(ta, N(ta, t).r);
+    free(N(ta, t).text);
+}
+
+/* ── ノード確保 ─────────────────────────────────────────*/
+static uint32_t ta_rand(UITextArea* ta) {
+    uint32_t x = ta->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return ta->rng = x;
+}
+
+static int node_new(UITextArea* ta) {
+    int i;
+    if (ta->free_count > 0) {
+        i = ta->free_ids[--ta->free_count];
+    } else {
+        if (ta->node_count == ta->node_cap) {
+            int cap = ta->node_cap ? ta->node_cap * 2 : 64;
+            TANode* nn = (TANode*)realloc(ta->nodes, sizeof(TANode) * (size_t)cap);
+            if (!nn) return 0;
+            ta->nodes    = nn;
+            ta->node_cap = cap;
+        }
+        i = ta->node_count++;
+    }
+    TANode* n = &N(ta, i);
+    memset(n, 0, sizeof(*n));
+    n->text = (char*)malloc(16);
+    if (!n->text) return 0;
+    n->text[0] = '\0';
+    n->cap  = 16;
+    n->rows = 1;
+    n->prio = ta_rand(ta);
+    pull(ta, i);
+    return i;
+}
+
+static void node_free(UITextArea* ta, int i) {
+    free(N(ta, i).text);
+    N(ta, i).text = NULL;
+    if (ta->free_count == ta->free_cap) {
+        int cap = ta->free_cap ? ta->free_cap * 2 : 64;
+        int* nf = (int*)realloc(ta->free_ids, sizeof(int) * (size_t)cap);
+        if (!nf) return;   /* 再利用できないだけ */
+        ta->free_ids = nf;
+        ta->free_cap = cap;
+    }
+    ta->free_ids[ta->free_count++] = i;
+}
+
+static bool text_reserve(TANode* n, int need) {
+    if (need + 1 <= n->cap) return true;
+    int cap = n->cap;
+    while (cap < need + 1) cap *= 2;
+    char* t = (char*)realloc(n->text, (size_t)cap);
+    if (!t) return false;
+    n->text = t;
+    n->cap  = cap;
+    return true;
+}
+
+/* ── 文書操作 ───────────────────────────────────────────*/
+
+/* 行 k の内容変更後: 折り返しキャッシュと集計を更新 */
+static void line_changed(UITextArea* ta, int k) {
+    int t = nth(ta, k);
+    N(ta, t).rows = line_rows(&N(ta, t), ta->wrap_cols);
+    touch(ta, ta->root, k);
+}
+
+/* 行 k の直後に空行を挿入し、そのノードを返す */
+static int line_insert_after(UITextArea* ta, int k) {
+    int nd = node_new(ta);
+    if (!nd) return 0;
+    int a, b;
+    split(ta, ta->root, k + 1, &a, &b);
+    ta->root = merge(ta, merge(ta, a, nd), b);
+    return nd;
+}
+
+static void line_remove(UITextArea* ta, int k) {
+    int a, b, m, c;
+    split(ta, ta->root, k, &a, &b);
+    split(ta, b, 1, &m, &c);
+    ta->root = merge(ta, a, c);
+    if (m) node_free(ta, m);
+}
+
+static void doc_clear(UITextArea* ta) {
+    free_tree(ta, ta->root);
+    ta->node_count = 1;           /* 0 番は番兵 */
+    ta->free_count = 0;
+    ta->root = node_new(ta);      /* 空文書 = 空行 1 つ */
+    ta->caret_line = ta->caret_col = 0;
+    ta->sticky_x   = -1;
+    ta->scroll_row = 0;
+}
+
+static UITextArea* area_get(int id) {
+    UITextArea* found = NULL;
+    ui_profile_begin("ui.textarea_get");
+    for (int i = 0; i < UI_MAX_TEXTAREAS && !found; ++i)
+        if (areas[i].used && areas[i].id == id) found = &areas[i];
+    for (int i = 0; i < UI_MAX_TEXTAREAS && !found; ++i) {
+        if (!areas[i].used) {
+            UITextArea* ta = &areas[i];
+            memset(ta, 0, sizeof(*ta));
+            ta->nodes = (TANode*)calloc(64, sizeof(TANode));
+            if (!ta->nodes) break;
+            ta->node_cap = 64;
+            ta->id      = id;
+            ta->used    = true;
+            ta->rng     = (0x9E3779B9u ^ (uint32_t)id) | 1u;
+            ta->char_w  = 8.0f;
+            ta->line_h  = 16.0f;
+            ta->wrap    = true;
+            doc_clear(ta);
+            found = ta;
+        }
+    }
+    ui_profile_end();
+    return found;
+}
+
+void ui_textarea_reset_all(void) {
+    for (int i = 0; i < UI_MAX_TEXTAREAS; ++i) {
+        UITextArea* ta = &areas[i];
+        if (!ta->used) continue;
+        free_tree(ta, ta->root);
+        free(ta->nodes);
+        free(ta->free_ids);
+        free(ta->vis);
+        memset(ta, 0, sizeof(*ta));
+    }
+}
+
+/* ── 表示行の計算 ───────────────────────────────────────*/
+static int visible_rows(const UITextArea* ta) {
+    if (ta->line_h <= 0.0f || ta->h <= 0.0f) return 1;
+    int n = (int)floorf(ta->h / ta->line_h);
+    return n > 0 ? n : 1;
+}
+
+static void clamp_scroll(UITextArea* ta) {
+    int max_scroll = N(ta, ta->root).sum_rows - visible_rows(ta);
+    if (ta->scroll_row > max_scroll) ta->scroll_row = max_scroll;
+    if (ta->scroll_row < 0) ta->scroll_row = 0;
+}
+
+/* キャレットの絶対表示行と、その表示行内の桁 (コードポイント) */
+static int caret_row(UITextArea* ta, int* xcol) {
+    const TANode* nd = &N(ta, nth(ta, ta->caret_line));
+    int rs, re;
+    int r = row_of_col(nd, ta->wrap_cols, ta->caret_col, &rs, &re);
+    if (xcol) *xcol = u8_count(nd->text, rs, ta->caret_col);
+    return rows_before(ta, ta->caret_line) + r;
+}
+
+static void ensure_caret_visible(UITextArea* ta) {
+    int row = caret_row(ta, NULL);
+    int vis = visible_rows(ta);
+    if (row < ta->scroll_row) ta->scroll_row = row;
+    if (row >= ta->scroll_row + vis) ta->scroll_row = row - vis + 1;
+    clamp_scroll(ta);
+}
+
+/* 絶対表示行 row の xcol 桁目にキャレットを置く */
+static void caret_to_row(UITextArea* ta, int row, int xcol) {
+    int rin;
+    int line = line_at_row(ta, row, &rin);
+    const TANode* nd = &N(ta, nth(ta, line));
+    int rs, re;
+    row_span(nd, ta->wrap_cols, rin, &rs, &re);
+    ta->caret_line = line;
+    ta->caret_col  = col_in_row(nd, rs, re, xcol);
+}
+
+static void set_wrap_cols(UITextArea* ta) {
+    int cols = 0;
+    if (ta->wrap && ta->char_w > 0.0f && ta->w > 0.0f) {
+        cols = (int)floorf(ta->w / ta->char_w);
+        if (cols < 1) cols = 1;
+    }
+    if (cols == ta->wrap_cols) return;
+    ui_profile_begin("ui.textarea_rewrap");
+    ta->wrap_cols = cols;
+    rewrap_all(ta, ta->root);
+    clamp_scroll(ta);
+    ui_profile_end();
+}
+
+/* ── ウィジェット ────────────────────────────────────────*/
+bool ui_textarea(int id, float x, float y, float w, float h, float wheel_dy) {
+    UITextArea* ta = area_get(id);
+    if (!ta) return false;
+    ta->x = x; ta->y = y; ta->w = w; ta->h = h;
+    set_wrap_cols(ta);
+
+    if (wheel_dy != 0.0f && ui_hover(x, y, w, h)) {
+        ta->scroll_row += (int)(wheel_dy * 3.0f);
+        clamp_scroll(ta);
+    }
+    float mx, my;
+    bool  clicked;
+    ui_mouse_state(&mx, &my, NULL, &clicked);
+    if (clicked && ui_hover(x, y, w, h)) {
+        /* クリック位置→キャレット: 表示行は O(1)、論理行の特定は O(log n) */
+        int row  = ta->scroll_row + (int)floorf((my - y) / ta->line_h);
+        int xcol = (int)floorf((mx - x) / ta->char_w + 0.5f);
+        caret_to_row(ta, row, xcol < 0 ? 0 : xcol);
+        ta->sticky_x = -1;
+        ta->focused  = true;
+    } else if (clicked) {
+        ta->focused = false;      /* 枠外クリックでフォーカス解除 */
+    }
+    return ta->focused;
+}
+
+void ui_textarea_config(int id, float char_w, float line_h, bool wrap) {
+    UITextArea* ta = area_get(id);
+    if (!ta) return;
+    ta->char_w = char_w > 0.0f ? char_w : 8.0f;
+    ta->line_h = line_h > 0.0f ? line_h : 16.0f;
+    ta->wrap   = wrap;
+    set_wrap_cols(ta);
+}
+
+/* ── 編集 ───────────────────────────────────────────────*/
+static void insert_text(UITextArea* ta, const char* text) {
+    int   k   = ta->caret_line;
+    int   t   = nth(ta, k);
+    if (!strpbrk(text, "\r\n")) {
+        /* 改行を含まない入力 (通常のキー入力) は行内の memmove だけ */
+        TANode* nd = &N(ta, t);
+        int n = (int)strlen(text);
+        if (!text_reserve(nd, nd->len + n)) return;
+        memmove(nd->text + ta->caret_col + n, nd->text + ta->caret_col,
+                (size_t)(nd->len - ta->caret_col) + 1);
+        memcpy(nd->text + ta->caret_col, text, (size_t)n);
+        nd->len       += n;
+        ta->caret_col += n;
+        line_changed(ta, k);
+        return;
+    }
+    /* キャレット以降を退避し、最後に付け直す (改行ごとに末尾を運ばない) */
+    int   tail_len = N(ta, t).len - ta->caret_col;
+    char* tail = (char*)malloc((size_t)tail_len + 1);
+    if (!tail) return;
+    memcpy(tail, N(ta, t).text + ta->caret_col, (size_t)tail_len);
+    N(ta, t).len = ta->caret_col;
+    N(ta, t).text[N(ta, t).len] = '\0';
+
+    const char* p = text;
+    for (;;) {
+        const char* seg = p;
+        while (*p && *p != '\n' && *p != '\r') p++;
+        int n = (int)(p - seg);
+        if (n > 0 && text_reserve(&N(ta, t), N(ta, t).len + n)) {
+            memcpy(N(ta, t).text + N(ta, t).len, seg, (size_t)n);
+            N(ta, t).len += n;
+            N(ta, t).text[N(ta, t).len] = '\0';
+        }
+        if (*p == '\r') { p++; continue; }
+        if (*p != '\n') break;
+        p++;
+        line_changed(ta, k);
+        int nd = line_insert_after(ta, k);
+        if (!nd) break;
+        k++;
+        t = nd;
+    }
+    ta->caret_line = k;
+    ta->caret_col  = N(ta, t).len;
+    if (tail_len > 0 && text_reserve(&N(ta, t), N(ta, t).len + tail_len)) {
+        memcpy(N(ta, t).text + N(ta, t).len, tail, (size_t)tail_len);
+        N(ta, t).len += tail_len;
+        N(ta, t).text[N(ta, t).len] = '\0';
+    }
+    free(tail);
+    line_changed(ta, k);
+}
+
+/* 行 k と k+1 を結合する */
+static void join_next(UITextArea* ta, int k) {
+    int a = nth(ta, k), b = nth(ta, k + 1);
+    if (!b || !text_reserve(&N(ta, a), N(ta, a).len + N(ta, b).len)) return;
+    memcpy(N(ta, a).text + N(ta, a).len, N(ta, b).text, (size_t)N(ta, b).len + 1);
+    N(ta, a).len += N(ta, b).len;
+    line_remove(ta, k + 1);
+    line_changed(ta, k);
+}
+
+void ui_textarea_set_text(int id, const char* text) {
+    UITextArea* ta = area_get(id);
+    if (!ta) return;
+    ui_profile_begin("ui.textarea_edit");
+    doc_clear(ta);
+    if (text && *text) insert_text(ta, text);
+    ta->caret_line = ta->caret_col = 0;
+    ta->scroll_row = 0;
+    ui_profile_end();
+}
+
+void ui_textarea_insert(int id, const char* text) {
+    UITextArea* ta = area_get(id);
+    if (!ta || !text || !*text) return;
+    ui_profile_begin("ui.textarea_edit");
+    insert_text(ta, text);
+    ta->sticky_x = -1;
+    ensure_caret_visible(ta);
+    ui_profile_end();
+}
+
+void ui_textarea_backspace(int id, int count) {
+    UITextArea* ta = area_get(id);
+    if (!ta || count <= 0) return;
+    ui_profile_begin("ui.textarea_edit");
+    int t = nth(ta, ta->caret_line);
+    bool dirty = false;
+    while (count-- > 0) {
+        if (ta->caret_col > 0) {
+            TANode* nd = &N(ta, t);
+            int from = u8_prev(nd->text, ta->caret_col);
+            memmove(nd->text + from, nd->text + ta->caret_col,
+                    (size_t)(nd->len - ta->caret_col) + 1);
+            nd->len -= ta->caret_col - from;
+            ta->caret_col = from;
+            dirty = true;
+        } else if (ta->caret_line > 0) {
+            if (dirty) line_changed(ta, ta->caret_line);
+            ta->caret_line--;
+            ta->caret_col = N(ta, nth(ta, ta->caret_line)).len;
+            join_next(ta, ta->caret_line);
+            t = nth(ta, ta->caret_line);
+            dirty = false;
+        } else {
+            break;
+        }
+    }
+    if (dirty) line_changed(ta, ta->caret_line);
+    ta->sticky_x = -1;
+    ensure_caret_visible(ta);
+    ui_profile_end();
+}
+
+void ui_textarea_delete(int id, int count) {
+    UITextArea* ta = area_get(id);
+    if (!ta || count <= 0) return;
+    ui_profile_begin("ui.textarea_edit");
+    int t = nth(ta, ta->caret_line);
+    bool dirty = false;
+    while (count-- > 0) {
+        TANode* nd = &N(ta, t);
+        if (ta->caret_col < nd->len) {
+            int to = u8_next(nd->text, nd->len, ta->caret_col);
+            memmove(nd->text + ta->caret_col, nd->text + to,
+                    (size_t)(nd->len - to) + 1);
+            nd->len -= to - ta->caret_col;
+            dirty = true;
+        } else if (ta->caret_line + 1 < N(ta, ta->root).cnt) {
+            join_next(ta, ta->caret_line);
+            t = nth(ta, ta->caret_line);
+            dirty = false;
+        } else {
+            break;
+        }
+    }
+    if (dirty) line_changed(ta, ta->caret_line);
+    ta->sticky_x = -1;
+    ensure_caret_visible(ta);
+    ui_profile_end();
+}
+
+/* ── キャレット移動 ─────────────────────────────────────*/
+void ui_textarea_move(int id, int dir, int count) {
+    UITextArea* ta = area_get(id);
+    if (!ta) return;
+    if (count < 1) count = 1;
+    int lines = N(ta, ta->root).cnt;
+    bool vertical = false;
+
+    switch (dir) {
+    case UI_CARET_LEFT:
+        while (count-- > 0) {
+            if (ta->caret_col > 0)
+                ta->caret_col = u8_prev(N(ta, nth(ta, ta->caret_line)).text, ta->caret_col);
+            else if (ta->caret_line > 0)
+                ta->caret_col = N(ta, nth(ta, --ta->caret_line)).len;
+        }
+        break;
+    case UI_CARET_RIGHT:
+        while (count-- > 0) {
+            const TANode* nd = &N(ta, nth(ta, ta->caret_line));
+            if (ta->caret_col < nd->len)
+                ta->caret_col = u8_next(nd->text, nd->len, ta->caret_col);
+            else if (ta->caret_line + 1 < lines) {
+                ta->caret_line++;
+                ta->caret_col = 0;
+            }
+        }
+        break;
+    case UI_CARET_UP:
+    case UI_CARET_DOWN:
+    case UI_CARET_PAGE_UP:
+    case UI_CARET_PAGE_DOWN: {
+        int xcol;
+        int row = caret_row(ta, &xcol);
+        if (ta->sticky_x < 0) ta->sticky_x = xcol;
+        int step = (dir == UI_CARET_PAGE_UP || dir == UI_CARET_PAGE_DOWN)
+                 ? visible_rows(ta) * count : count;
+        if (dir == UI_CARET_UP || dir == UI_CARET_PAGE_UP) step = -step;
+        int total = N(ta, ta->root).sum_rows;
+        row += step;
+        if (row < 0) row = 0;
+        if (row >= total) row = total - 1;
+        caret_to_row(ta, row, ta->sticky_x);
+        vertical = true;
+        break;
+    }
+    case UI_CARET_HOME:
+    case UI_CARET_END: {
+        const TANode* nd = &N(ta, nth(ta, ta->caret_line));
+        int rs, re;
+        row_of_col(nd, ta->wrap_cols, ta->caret_col, &rs, &re);
+        ta->caret_col = (dir == UI_CARET_HOME) ? rs : col_in_row(nd, rs, re, 1 << 30);
+        break;
+    }
+    case UI_CARET_DOC_START:
+        ta->caret_line = ta->caret_col = 0;
+        break;
+    case UI_CARET_DOC_END:
+        ta->caret_line = lines - 1;
+        ta->caret_col  = N(ta, nth(ta, ta->caret_line)).len;
+        break;
+    default:
+        return;
+    }
+    if (!vertical) ta->sticky_x = -1;
+    ensure_caret_visible(ta);
+}
+
+/* ── 取得 ───────────────────────────────────────────────*/
+static void copy_tree(UITextArea* ta, int t, char* buf, long size, long* o) {
+    if (!t) return;
+    copy_tree(ta, N(ta, t).l, buf, size, o);
+    const TANode* nd = &N(ta, t);
+    long n = nd->len;
+    if (*o < size) {
+        long room = size - *o;
+        memcpy(buf + *o, nd->text, (size_t)(n < room ? n : room));
+    }
+    *o += n;
+    if (*o < size) buf[*o] = '\n';
+    (*o)++;
+    copy_tree(ta, N(ta, t).r, buf, size, o);
+}
+
+long ui_textarea_get_text(int id, char* buf, long size) {
+    UITextArea* ta = area_get(id);
+    if (!ta) { if (buf && size > 0) buf[0] = '\0'; return 0; }
+    long total = N(ta, ta->root).bytes - 1;   /* 最終行の改行は無い */
+    if (!buf || size <= 0) return total;
+    long o = 0;
+    copy_tree(ta, ta->root, buf, size - 1, &o);
+    buf[total < size - 1 ? total : size - 1] = '\0';
+    return total;
+}
+
+int ui_textarea_line_count(int id) {
+    UITextArea* ta = area_get(id);
+    return ta ? N(ta, ta->root).cnt : 0;
+}
+
+void ui_textarea_caret(int id, int* line, int* col, float* px, float* py) {
+    UITextArea* ta = area_get(id);
+    if (!ta) return;
+    int xcol;
+    int row = caret_row(ta, &xcol);
+    if (line) *line = ta->caret_line;
+    if (col)  *col  = u8_count(N(ta, nth(ta, ta->caret_line)).text, 0, ta->caret_col);
+    if (px)   *px   = ta->x + xcol * ta->char_w;
+    if (py)   *py   = ta->y + (row - ta->scroll_row) * ta->line_h;
+}
+
+const char* ui_textarea_visible_text(int id, int* first_line) {
+    UITextArea* ta = area_get(id);
+    if (!ta) { if (first_line) *first_line = 0; return ""; }
+    ui_profile_begin("ui.textarea_visible");
+    int rin;
+    int line  = line_at_row(ta, ta->scroll_row, &rin);
+    int lines = N(ta, ta->root).cnt;
+    int want  = visible_rows(ta);
+    if (first_line) *first_line = line;
+
+    long o = 0;
+    for (int r = 0; r < want && line < lines; ++r) {
+        const TANode* nd = &N(ta, nth(ta, line));
+        int rs, re;
+        row_span(nd, ta->wrap_cols, rin, &rs, &re);
+        long need = o + (re - rs) + 2;
+        if (need > ta->vis_cap) {
+            long cap = ta->vis_cap ? ta->vis_cap : 256;
+            while (cap < need) cap *= 2;
+            char* nv = (char*)realloc(ta->vis, (size_t)cap);
+            if (!nv) break;
+            ta->vis = nv;
+            ta->vis_cap = cap;
+        }
+        if (r > 0) ta->vis[o++] = '\n';
+        memcpy(ta->vis + o, nd->text + rs, (size_t)(re - rs));
+        o += re - rs;
+        if (++rin >= nd->rows) { rin = 0; line++; }
+    }
+    ui_profile_end();
+    if (!ta->vis) return "";
+    ta->vis[o] = '\0';
+    return ta->vis;
+}
@@ -0,0 +1,462 @@
+/**
+ * src/ui_tree.c — ツリービュー (平坦化した表示ノード配列)
+ *
+ * ノードは構造体配列ではなく parent / first / last / next / depth / flags の
+ * 並列配列で持つ。0 番は非表示の根 (常に展開)。
+ * vis[n] は「n が展開中なら表示される子孫の数」(折り畳み中は 0) で、
+ * 展開/折り畳み/追加のたびに祖先へ差分を伝える (折り畳まれた祖先で止まる)。
+ * flat[] は表示順のノード列。展開時は部分木の表示ノードだけを挿入、
+ * 折り畳み時は flat[pos+1 .. pos+vis] を削除する。
+ * pos[n] (flat 内の位置) は遅延更新: flat[pos[n]] == n なら正しく、
+ * そうでなければ pos_valid 以降を振り直す。
+ *
+ * Copyright (c) 2026 Reo Shiozawa — MIT License
+ */
+#include "eng_ui.h"
+#include "eng_ui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define UI_MAX_TREES     4
+#define UI_TREE_PENDING  64
+
+enum {
+    TN_EXPANDED     = 1,
+    TN_HAS_CHILDREN = 2,   /* 子がある (未読み込みを含む) */
+    TN_LOADED       = 4,   /* 子を読み込み済み */
+    TN_REMOVED      = 8
+};
+
+typedef struct {
+    int          id;
+    bool         used;
+    int          count, cap;      /* 根を含むノード数 */
+    int*         parent;          /* 根は -1 */
+    int*         first;           /* 0 = 無し (根は子にならない) */
+    int*         last;
+    int*         next;
+    int*         depth;           /* 最上位 = 0, 根 = -1 */
+    int*         vis;
+    int*         pos;
+    uint8_t*     flags;
+    char**       label;
+    int*         free_ids;        /* 削除済みで再利用できるノード番号 */
+    int          free_count, free_cap;
+    /* 表示順の平坦配列 */
+    int*         flat;
+    int          flat_count, flat_cap;
+    int          pos_valid;       /* flat[0 .. pos_valid) の pos[] は振り直し済み */
+    /* 遅延読み込み */
+    UITreeLoadFn loader;
+    void*        loader_user;
+    int          pending[UI_TREE_PENDING];
+    int          pend_head, pend_count;
+    /* 表示 */
+    float        x, y, w, h, row_h, indent;
+    int          scroll_row;
+    int          selected;
+} UITree;
+
+static UITree trees[UI_MAX_TREES];
+
+/* ── 確保 ───────────────────────────────────────────────*/
+static bool grow_int(int** p, int cap) {
+    int* n = (int*)realloc(*p, sizeof(int) * (size_t)cap);
+    if (!n) return false;
+    *p = n;
+    return true;
+}
+
+static bool nodes_reserve(UITree* t, int need) {
+    if (need <= t->cap) return true;
+    int cap = t->cap ? t->cap : 256;
+    while (cap < need) cap *= 2;
+    if (!grow_int(&t->parent, cap) || !grow_int(&t->first, cap) ||
+        !grow_int(&t->last, cap)   || !grow_int(&t->next, cap)  ||
+        !grow_int(&t->depth, cap)  || !grow_int(&t->vis, cap)   ||
+        !grow_int(&t->pos, cap))
+        return false;
+    uint8_t* f = (uint8_t*)realloc(t->flags, (size_t)cap);
+    if (!f) return false;
+    t->flags = f;
+    char** l = (char**)realloc(t->label, sizeof(char*) * (size_t)cap);
+    if (!l) return false;
+    t->label = l;
+    t->cap = cap;
+    return true;
+}
+
+static bool flat_reserve(UITree* t, int extra) {
+    int need = t->flat_count + extra;
+    if (need <= t->flat_cap) return true;
+    int cap = t->flat_cap ? t->flat_cap : 256;
+    while (cap < need) cap *= 2;
+    if (!grow_int(&t->flat, cap)) return false;
+    t->flat_cap = cap;
+    return true;
+}
+
+static void tree_free(UITree* t) {
+    for (int i = 0; i < t->count; ++i) free(t->label[i]);
+    free(t->parent); free(t->first); free(t->last); free(t->next);
+    free(t->depth);  free(t->vis);   free(t->pos);  free(t->flags);
+    free(t->label);  free(t->flat);  free(t->free_ids);
+}
+
+/* 根だけの状態にする */
+static bool tree_init(UITree* t) {
+    int id = t->id;
+    tree_free(t);
+    memset(t, 0, sizeof(*t));
+    t->id = id;
+    t->used = true;
+    t->selected = -1;
+    if (!nodes_reserve(t, 1)) return false;
+    t->count     = 1;
+    t->parent[0] = -1;
+    t->first[0]  = t->last[0] = t->next[0] = 0;
+    t->depth[0]  = -1;
+    t->vis[0]    = 0;
+    t->pos[0]    = -1;
+    t->flags[0]  = TN_EXPANDED | TN_LOADED;
+    t->label[0]  = NULL;
+    return true;
+}
+
+static UITree* tree_get(int id) {
+    UITree* found = NULL;
+    ui_profile_begin("ui.tree_get");
+    for (int i = 0; i < UI_MAX_TREES && !found; ++i)
+        if (trees[i].used && trees[i].id == id) found = &trees[i];
+    for (int i = 0; i < UI_MAX_TREES && !found; ++i) {
+        if (!trees[i].used) {
+            memset(&trees[i], 0, sizeof(UITree));
+            trees[i].id = id;
+            if (tree_init(&trees[i])) found = &trees[i];
+            else { tree_free(&trees[i]); memset(&trees[i], 0, sizeof(UITree)); }
+        }
+    }
+    ui_profile_end();
+    return found;
+}
+
+void ui_tree_reset_all(void) {
+    for (int i = 0; i < UI_MAX_TREES; ++i) {
+        if (trees[i].used) tree_free(&trees[i]);
+        memset(&trees[i], 0, sizeof(UITree));
+    }
+}
+
+static bool valid_node(const UITree* t, int n) {
+    return t && n > 0 && n < t->count && !(t->flags[n] & TN_REMOVED);
+}
+
+/* ── 平坦配列 ───────────────────────────────────────────*/
+
+/* 祖先がすべて展開中なら表示されている */
+static bool is_visible(const UITree* t, int n) {
+    for (int a = t->parent[n]; a >= 0; a = t->parent[a])
+        if (!(t->flags[a] & TN_EXPANDED)) return false;
+    return true;
+}
+
+/* n の flat 内位置 (根は -1)。表示中であることが前提。 */
+static int flat_pos(UITree* t, int n) {
+    if (n == 0) return -1;
+    int p = t->pos[n];
+    if (p >= 0 && p < t->flat_count && t->flat[p] == n) return p;
+    ui_profile_begin("ui.tree_reindex");
+    for (int i = t->pos_valid; i < t->flat_count; ++i) t->pos[t->flat[i]] = i;
+    t->pos_valid = t->flat_count;
+    ui_profile_end();
+    return t->pos[n];
+}
+
+static void flat_insert(UITree* t, int at, const int* nodes, int cnt) {
+    if (cnt <= 0 || !flat_reserve(t, cnt)) return;
+    memmove(t->flat + at + cnt, t->flat + at,
+            sizeof(int) * (size_t)(t->flat_count - at));
+    memcpy(t->flat + at, nodes, sizeof(int) * (size_t)cnt);
+    t->flat_count += cnt;
+    for (int i = 0; i < cnt; ++i) t->pos[nodes[i]] = at + i;
+    if (t->pos_valid > at) t->pos_valid = at;
+}
+
+static void flat_remove(UITree* t, int at, int cnt) {
+    if (cnt <= 0) return;
+    memmove(t->flat + at, t->flat + at + cnt,
+            sizeof(int) * (size_t)(t->flat_count - at - cnt));
+    t->flat_count -= cnt;
+    if (t->pos_valid > at) t->pos_valid = at;
+}
+
+/* from から上へ、展開中の祖先の vis に delta を足す */
+static void vis_propagate(UITree* t, int from, int delta) {
+    for (int a = from; a >= 0 && (t->flags[a] & TN_EXPANDED); a = t->parent[a])
+        t->vis[a] += delta;
+}
+
+/* 展開済み n の表示子孫を深さ優先順に out へ (vis[n] 個) */
+static void gather_visible(const UITree* t, int n, int* out) {
+    int c = t->first[n], k = 0;
+    if (!c) return;
+    for (;;) {
+        out[k++] = c;
+        if ((t->flags[c] & TN_EXPANDED) && t->first[c]) { c = t->first[c]; continue; }
+        while (c != n && !t->next[c]) c = t->parent[c];
+        if (c == n) break;
+        c = t->next[c];
+    }
+}
+
+/* ── 展開 / 折り畳み ────────────────────────────────────*/
+static void pending_push(UITree* t, int n) {
+    for (int i = 0; i < t->pend_count; ++i)
+        if (t->pending[(t->pend_head + i) % UI_TREE_PENDING] == n) return;
+    if (t->pend_count == UI_TREE_PENDING) return;   /* 満杯なら次の展開操作で再要求 */
+    t->pending[(t->pend_head + t->pend_count) % UI_TREE_PENDING] = n;
+    t->pend_count++;
+}
+
+static void do_expand(UITree* t, int n) {
+    if (t->flags[n] & TN_EXPANDED) return;
+    if (!(t->flags[n] & TN_LOADED) && (t->flags[n] & TN_HAS_CHILDREN) && !t->first[n]) {
+        if (!t->loader) { pending_push(t, n); return; }
+        t->flags[n] |= TN_LOADED;
+        t->loader(t->id, n, t->loader_user);   /* ui_tree_add で配列が伸びることがある */
+        if (!valid_node(t, n)) return;
+    }
+    t->flags[n] |= TN_LOADED;
+
+    ui_profile_begin("ui.tree_expand");
+    int total = 0;
+    for (int c = t->first[n]; c; c = t->next[c]) total += 1 + t->vis[c];
+    t->flags[n] |= TN_EXPANDED;
+    t->vis[n] = total;
+    vis_propagate(t, t->parent[n], total);
+    if (total > 0 && is_visible(t, n)) {
+        int* buf = (int*)malloc(sizeof(int) * (size_t)total);
+        if (buf) {
+            gather_visible(t, n, buf);
+            flat_insert(t, flat_pos(t, n) + 1, buf, total);
+            free(buf);
+        }
+    }
+    ui_profile_end();
+}
+
+static void do_collapse(UITree* t, int n) {
+    if (!(t->flags[n] & TN_EXPANDED)) return;
+    ui_profile_begin("ui.tree_expand");
+    bool shown = is_visible(t, n);
+    int  cnt   = t->vis[n];
+    int  at    = shown ? flat_pos(t, n) + 1 : 0;
+    vis_propagate(t, t->parent[n], -cnt);
+    t->flags[n] &= (uint8_t)~TN_EXPANDED;
+    t->vis[n] = 0;
+    if (shown) flat_remove(t, at, cnt);
+    ui_profile_end();
+}
+
+/* ── 公開 API ───────────────────────────────────────────*/
+void ui_tree_clear(int id) {
+    UITree* t = tree_get(id);
+    if (!t) return;
+    UITreeLoadFn fn = t->loader;
+    void* user = t->loader_user;
+    if (tree_init(t)) { t->loader = fn; t->loader_user = user; }
+    else { tree_free(t); memset(t, 0, sizeof(*t)); }
+}
+
+int ui_tree_add(int id, int parent, const char* label, bool has_children) {
+    UITree* t = tree_get(id);
+    if (!t) return -1;
+    if (parent < 0) parent = 0;
+    if (parent != 0 && !valid_node(t, parent)) return -1;
+    if (!t->free_count && !nodes_reserve(t, t->count + 1)) return -1;
+
+    size_t len = label ? strlen(label) : 0;
+    char* lb = (char*)malloc(len + 1);
+    if (!lb) return -1;
+    if (len) memcpy(lb, label, len);
+    lb[len] = '\0';
+    int n = t->free_count ? t->free_ids[--t->free_count] : t->count++;
+
+    t->parent[n] = parent;
+    t->first[n]  = t->last[n] = t->next[n] = 0;
+    t->depth[n]  = t->depth[parent] + 1;
+    t->vis[n]    = 0;
+    t->pos[n]    = -1;
+    t->flags[n]  = has_children ? TN_HAS_CHILDREN : 0;
+    t->label[n]  = lb;
+
+    if (t->last[parent]) t->next[t->last[parent]] = n;
+    else                 t->first[parent] = n;
+    t->last[parent] = n;
+    t->flags[parent] |= TN_HAS_CHILDREN | TN_LOADED;
+
+    if (t->flags[parent] & TN_EXPANDED) {
+        int old = t->vis[parent];
+        vis_propagate(t, parent, 1);
+        if (is_visible(t, parent))
+            flat_insert(t, flat_pos(t, parent) + 1 + old, &n, 1);
+    }
+    return n;
+}
+
+void ui_tree_remove_children(int id, int node) {
+    UITree* t = tree_get(id);
+    if (!valid_node(t, node)) return;
+    do_collapse(t, node);
+    /* 子孫を削除済みにし、番号を ui_tree_add で再利用できるようにする */
+    int c = t->first[node];
+    while (c) {
+        t->flags[c] |= TN_REMOVED;
+        free(t->label[c]);
+        t->label[c] = NULL;
+        if (c == t->selected) t->selected = -1;
+        if (t->free_count == t->free_cap) {
+            int cap = t->free_cap ? t->free_cap * 2 : 64;
+            if (grow_int(&t->free_ids, cap)) t->free_cap = cap;
+        }
+        if (t->free_count < t->free_cap) t->free_ids[t->free_count++] = c;
+        if (t->first[c]) { c = t->first[c]; continue; }
+        while (c != node && !t->next[c]) c = t->parent[c];
+        if (c == node) break;
+        c = t->next[c];
+    }
+    t->first[node] = t->last[node] = 0;
+    t->flags[node] &= (uint8_t)~TN_LOADED;
+
+    /* 再利用された番号が読込要求として返らないよう、削除分をキューから除く */
+    int kept = 0;
+    for (int i = 0; i < t->pend_count; ++i) {
+        int n = t->pending[(t->pend_head + i) % UI_TREE_PENDING];
+        if (!(t->flags[n] & TN_REMOVED))
+            t->pending[(t->pend_head + kept++) % UI_TREE_PENDING] = n;
+    }
+    t->pend_count = kept;
+}
+
+void ui_tree_set_loader(int id, UITreeLoadFn fn, void* user) {
+    UITree* t = tree_get(id);
+    if (!t) return;
+    t->loader      = fn;
+    t->loader_user = user;
+}
+
+void ui_tree_expand(int id, int node, bool expanded) {
+    UITree* t = tree_get(id);
+    if (!valid_node(t, node)) return;
+    if (expanded) do_expand(t, node);
+    else          do_collapse(t, node);
+}
+
+bool ui_tree_is_expanded(int id, int node) {
+    UITree* t = tree_get(id);
+    return valid_node(t, node) && (t->flags[node] & TN_EXPANDED);
+}
+
+int ui_tree_pending_load(int id) {
+    UITree* t = tree_get(id);
+    while (t && t->pend_count > 0) {
+        int n = t->pending[t->pend_head];
+        t->pend_head = (t->pend_head + 1) % UI_TREE_PENDING;
+        t->pend_count--;
+        if (!valid_node(t, n)) continue;
+        t->flags[n] |= TN_LOADED;
+        return n;
+    }
+    return -1;
+}
+
+/* ── ウィジェット ────────────────────────────────────────*/
+static void clamp_scroll(UITree* t) {
+    int full = t->row_h > 0.0f ? (int)floorf(t->h / t->row_h) : 0;
+    int max_scroll = t->flat_count - (full > 0 ? full : 0);
+    if (t->scroll_row > max_scroll) t->scroll_row = max_scroll;
+    if (t->scroll_row < 0) t->scroll_row = 0;
+}
+
+int ui_tree(int id, float x, float y, float w, float h,
+            float row_h, float indent, float wheel_dy) {
+    UITree* t = tree_get(id);
+    if (!t) return -1;
+    t->x = x; t->y = y; t->w = w; t->h = h;
+    t->row_h  = row_h;
+    t->indent = indent;
+
+    if (wheel_dy != 0.0f && ui_hover(x, y, w, h))
+        t->scroll_row += (int)(wheel_dy * 3.0f);
+    clamp_scroll(t);
+
+    int clicked = -1;
+    if (row_h > 0.0f && ui_click(x, y, w, h)) {
+        float mx, my;
+        ui_mouse_state(&mx, &my, NULL, NULL);
+        /* 行 → ノードは平坦配列の添字 1 回 */
+        int row = t->scroll_row + (int)floorf((my - y) / row_h);
+        if (row >= 0 && row < t->flat_count) {
+            int n = t->flat[row];
+            bool toggle = (t->flags[n] & TN_HAS_CHILDREN)
+                       && mx < x + (float)(t->depth[n] + 1) * indent;
+            if (toggle) {
+                t->pos[n] = row;    /* 位置は既知なので振り直し不要 */
+                if (t->flags[n] & TN_EXPANDED) do_collapse(t, n);
+                else                           do_expand(t, n);
+                clamp_scroll(t);
+            } else {
+                clicked = t->selected = n;
+            }
+        }
+    }
+    return clicked;
+}
+
+int ui_tree_visible(int id, int* first) {
+    UITree* t = tree_get(id);
+    if (!t) { if (first) *first = 0; return 0; }
+    clamp_scroll(t);
+    int n = t->row_h > 0.0f ? (int)ceilf(t->h / t->row_h) : 0;
+    if (t->scroll_row + n > t->flat_count) n = t->flat_count - t->scroll_row;
+    if (first) *first = t->scroll_row;
+    return n > 0 ? n : 0;
+}
+
+int ui_tree_row_node(int id, int row) {
+    UITree* t = tree_get(id);
+    if (!t || row < 0 || row >= t->flat_count) return -1;
+    return t->flat[row];
+}
+
+int ui_tree_visible_count(int id) {
+    UITree* t = tree_get(id);
+    return t ? t->flat_count : 0;
+}
+
+int ui_tree_node_depth(int id, int node) {
+    UITree* t = tree_get(id);
+    return valid_node(t, node) ? t->depth[node] : -1;
+}
+
+int ui_tree_node_parent(int id, int node) {
+    UITree* t = tree_get(id);
+    if (!valid_node(t, node)) return -1;
+    return t->parent[node] > 0 ? t->parent[node] : -1;
+}
+
+const char* ui_tree_node_label(int id, int node) {
+    UITree* t = tree_get(id);
+    return valid_node(t, node) && t->label[node] ? t->label[node] : "";
+}
+
+bool ui_tree_node_has_children(int id, int node) {
+    UITree* t = tree_get(id);
+    return valid_node(t, node) && (t->flags[node] & TN_HAS_CHILDREN);
+}
+
+int ui_tree_selected(int id) {
+    UITree* t = tree_get(id);
+    return t ? t->selected : -1;
+}